@@ -0,0 +1,62 @@
+#pragma once
+#include "IPathfinder.h"
+#include "OpenList.h"
+#include <cstdint>
+#include <vector>
+
+// Anytime Repairing A*: weighted A* runs with heuristic weight w, so its
+// first path costs at most w times the optimum and arrives quickly. w then
+// shrinks step by step towards 1. Each round reuses the g values found so far
+// and only re-expands the cells whose g improved after they were expanded (the
+// INCONS list), instead of starting over.
+//
+// step() keeps returning Running while a better path may exist; getPath()
+// holds the best path so far, and getSuboptimalityBound() how far from optimal
+// it can be, so a caller may stop as soon as the bound or its time budget
+// suffices. The heuristic is octile distance, which keeps the bounds valid.
+class ARAStarPathfinder : public IPathfinder {
+public:
+    explicit ARAStarPathfinder(double initialWeight = 2.5, double weightStep = 0.5);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override;
+    void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_peakOpen; }
+    double getSuboptimalityBound() const override { return m_bound; }
+
+    // Weight of the round in progress.
+    double getWeight() const { return m_weight / 100.0; }
+    long long getExpansionCount() const { return m_expansions; }
+    // Search state, round stamps and open list at their largest.
+    std::size_t getPeakMemoryBytes() const;
+
+private:
+    int heuristic(CellId cell) const;
+    // (g + w * h) in hundredths, ties going to the larger g.
+    std::uint64_t calculateKey(CellId cell) const;
+    // Ends a round: publishes the path, tightens the bound and, unless the
+    // path is now provably optimal, starts the next round with a smaller weight.
+    AlgoState finishRound();
+
+    std::string m_name;
+    int m_initialWeight; // weights are kept in hundredths
+    int m_weightStep;
+    int m_weight = 100;
+    double m_bound = 0.0;
+
+    IndexedDaryHeap<4> m_open;
+    std::size_t m_peakOpen = 0;
+    // Per round: cells expanded (CLOSED) and cells improved after expansion
+    // (INCONS), both stamped with the round number.
+    std::vector<std::uint32_t> m_closedRound;
+    std::vector<std::uint32_t> m_inconsRound;
+    std::vector<CellId> m_incons;
+    std::uint32_t m_round = 0;
+    long long m_expansions = 0;
+    bool m_done = false;
+
+    Point m_start;
+    Point m_end;
+    CellId m_endCell;
+};
\ No newline at end of file
@@ -1,23 +1,32 @@
 #pragma once
 #include "IPathfinder.h"
-#include <queue>
-
-using PQElement = std::pair<int, Point>;
+#include "OpenList.h"
+#include "LandmarkHeuristic.h"
+#include <memory>
 
 class AStarPathfinder : public IPathfinder {
 public:
-    AStarPathfinder(bool isDijkstra = false);
-    void init(Grid& grid) override;
+    // With landmarks, the heuristic is the ALT bound instead of Manhattan
+    // distance; the owner keeps the tables current for the grid.
+    AStarPathfinder(bool isDijkstra = false, OpenListKind openList = OpenListKind::LazyBinaryHeap,
+                    std::shared_ptr<const LandmarkHeuristic> landmarks = nullptr);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
     AlgoState step() override;
     std::string getName() const override;
     void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_open.getPeakSize(); }
+    // Dijkstra and the admissible ALT bound are exact; Manhattan overestimates diagonals.
+    double getSuboptimalityBound() const override;
 
 private:
-    int heuristic(const Point& a, const Point& b);
+    int heuristic(CellId cell, const Point& pos) const;
 
     bool m_isDijkstra;
     std::string m_name;
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> m_pq;
+    OpenList m_open;
+    std::shared_ptr<const LandmarkHeuristic> m_landmarks;
     Point m_start;
     Point m_end;
+    CellId m_endCell;
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include "IPathfinder.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <vector>
+
+enum class PathAlgorithm { AStar, Dijkstra, Bidirectional, JumpPointSearch, JumpPointSearchPlus };
+
+// JumpPointSearchPlus reads the grid's jump table, which must be built first.
+std::unique_ptr<IPathfinder> createPathfinder(PathAlgorithm algorithm);
+
+struct PathQuery {
+    Point start;
+    Point goal;
+};
+
+struct PathResult {
+    AlgoState state = AlgoState::PathNotFound;
+    std::vector<Point> path;
+    int cost = 0;
+};
+
+// Answers many start/goal queries on one grid in parallel. Each worker
+// thread owns a pathfinder (and so its own SearchState) and reuses it across
+// queries and calls; the grid is shared read-only and must not be edited
+// while run() is in progress.
+class BatchPathfinder {
+public:
+    // threads <= 0 uses one worker per hardware thread.
+    explicit BatchPathfinder(const Grid& grid, int threads = 0);
+
+    int getThreadCount() const { return m_pool.size(); }
+    // Results are in query order and do not depend on the thread count.
+    std::vector<PathResult> run(const std::vector<PathQuery>& queries, PathAlgorithm algorithm);
+
+private:
+    const Grid& m_grid;
+    ThreadPool m_pool;
+    PathAlgorithm m_algorithm = PathAlgorithm::AStar;
+    std::vector<std::unique_ptr<IPathfinder>> m_workers;
+};
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include "IPathfinder.h"
+#include "CooperativePlanner.h"
+#include <string>
+#include <vector>
+
+// Offline measurements, run with `--bench` instead of the interactive loop.
+namespace bench {
+    struct RunResult {
+        AlgoState state = AlgoState::Running;
+        long long steps = 0;
+        double milliseconds = 0.0;
+        int pathCost = 0;
+    };
+
+    // Open terrain with S in the top-left and E in the bottom-right corner and
+    // roughly wallPercent% of the other cells blocked.
+    Grid makeScatterMap(int rows, int cols, int wallPercent, unsigned seed);
+    // Initializes pf on grid and steps it until it stops running; only the steps are timed.
+    RunResult runToCompletion(IPathfinder& pf, const Grid& grid);
+    // count agents with distinct random starts and goals in the start's component;
+    // fewer if the component has less than two cells per agent.
+    std::vector<AgentTask> makeAgentTasks(const Grid& grid, int count, unsigned seed);
+
+    void runOpenListBenchmark();
+    void runJumpPointBenchmark();
+    void runReplanningBenchmark();
+    void runHierarchicalBenchmark();
+    void runUnreachableBenchmark();
+    void runLandmarkBenchmark();
+    void runBatchBenchmark();
+    void runParallelBidirectionalBenchmark();
+    void runDeltaSteppingBenchmark();
+    void runBitboardBfsBenchmark();
+    void runFlowFieldBenchmark();
+    void runCooperativeBenchmark();
+    void runAnytimeBenchmark();
+    void runMemoryBoundedBenchmark();
+    void runFrontierBenchmark();
+    void runAnyAngleBenchmark();
+    void runAll();
+}
\ No newline at end of file
@@ -1,25 +1,31 @@
 #pragma once
 #include "IPathfinder.h"
-#include <queue>
-
-using PQElement = std::pair<int, Point>;
+#include "OpenList.h"
+#include "LandmarkHeuristic.h"
+#include <memory>
 
 class BidirectionalPathfinder : public IPathfinder {
 public:
-    BidirectionalPathfinder();
-    void init(Grid& grid) override;
+    BidirectionalPathfinder(OpenListKind openList = OpenListKind::LazyBinaryHeap,
+                            std::shared_ptr<const LandmarkHeuristic> landmarks = nullptr);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
     AlgoState step() override;
     std::string getName() const override;
     void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_pq_fwd.getPeakSize() + m_pq_bwd.getPeakSize(); }
 
 private:
-    int heuristic(const Point& a, const Point& b);
+    // Estimate towards the end (forward search) or the start (backward search).
+    int heuristic(CellId cell, const Point& pos, bool forward) const;
 
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> m_pq_fwd;
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> m_pq_bwd;
+    std::string m_name;
+    OpenList m_pq_fwd;
+    OpenList m_pq_bwd;
+    std::shared_ptr<const LandmarkHeuristic> m_landmarks;
     
     Point m_start;
     Point m_end;
-    Point m_meetingPoint;
+    CellId m_meetingPoint;
     int m_bestPathCost;
 };
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include "Grid.h"
+#include <cstdint>
+#include <vector>
+
+enum class Neighborhood { Four, Eight };
+
+// Unweighted breadth-first search with one bit per cell. The map is copied
+// into row-aligned bitboards (bit k of word j = column 64j + k), so a whole
+// word of the frontier moves at once: shifts for west/east, the same word of
+// the rows above and below for north/south. Each layer only touches the words
+// next to the ones its frontier occupies.
+//
+// run() keeps the layers themselves, as a log of the (row, word, bits) it
+// added per layer, rather than a distance per cell: getPath() walks that log
+// backwards, and getDistance() expands it into a per-cell table on first use.
+//
+// Distances count moves (every move costs 1, as in the console program's
+// findPathBFS); with Neighborhood::Eight diagonal moves may cut corners, like
+// everywhere else in this project.
+class BitboardBfs {
+public:
+    explicit BitboardBfs(Neighborhood neighborhood = Neighborhood::Four) : m_neighborhood(neighborhood) {}
+
+    // Expands layers from source until the one that reaches target, or over
+    // the whole component when target is {-1, -1}. Returns target's layer
+    // (-1 if it is a wall or unreachable), or for a flood the deepest layer.
+    int run(const Grid& grid, const Point& source, const Point& target = {-1, -1});
+
+    // Reachability only: marks the source's component without layers by
+    // filling whole runs of open cells per word, revisiting a row only when
+    // a neighbouring row gained cells. Returns the number of cells reached.
+    int flood(const Grid& grid, const Point& source);
+    // Whether the last run() or flood() reached the cell.
+    bool isReached(const Point& p) const { return (m_seen[static_cast<size_t>(p.first + 1) * m_words + (p.second >> 6)] >> (p.second & 63)) & 1; }
+
+    // Layer of a cell in the last run; -1 if it was not reached.
+    int getDistance(const Point& p) const;
+    int getLayerCount() const { return m_layers; }
+    // A shortest path from the source to target, found by stepping down the
+    // layers; empty if target was not reached.
+    std::vector<Point> getPath(const Point& target) const;
+
+private:
+    // Bits a layer added to one word of the boards.
+    struct LayerWord {
+        int index; // row * m_words + word, rows counted from the padding row
+        std::uint64_t bits;
+    };
+
+    // Row q of a bitboard, where q = 1..rows; rows 0 and rows+1 stay empty.
+    std::uint64_t* row(std::vector<std::uint64_t>& board, int q) { return &board[static_cast<size_t>(q) * m_words]; }
+    // Frontier bits of word j of row q, shifted onto their west and east neighbours.
+    std::uint64_t spread(const std::uint64_t* frontier, int j) const;
+    // Sizes the boards for grid and copies its open cells.
+    void load(const Grid& grid);
+    // Layer of the cell in the log, or -1.
+    int findLayer(const Point& p) const;
+
+    Neighborhood m_neighborhood;
+    int m_rows = 0;
+    int m_cols = 0;
+    int m_words = 0; // per row
+    int m_layers = 0;
+
+    std::vector<std::uint64_t> m_open;
+    std::vector<std::uint64_t> m_seen;
+    std::vector<std::uint64_t> m_reach; // moves into each word this layer
+
+    // Layer k of the last run is m_log[m_layerStart[k] .. m_layerStart[k + 1]).
+    std::vector<LayerWord> m_log;
+    std::vector<std::size_t> m_layerStart;
+    std::vector<int> m_touched;      // words m_reach holds moves into this layer
+    std::vector<int> m_touchedLayer; // per word: layer it was last touched in
+    mutable std::vector<int> m_distance; // logical row-major, built by getDistance()
+    mutable bool m_distanceBuilt = false;
+    std::vector<char> m_queued; // flood() worklist membership, per row
+};
\ No newline at end of file
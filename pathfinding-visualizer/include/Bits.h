@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Portable wrappers for the bit-scan instructions used by the word-level grid code.
+namespace bits {
+    // Index of the lowest set bit; x must be non-zero.
+    inline int countTrailingZeros(std::uint64_t x) {
+    #ifdef _MSC_VER
+        unsigned long i;
+        _BitScanForward64(&i, x);
+        return static_cast<int>(i);
+    #else
+        return __builtin_ctzll(x);
+    #endif
+    }
+
+    // Index of the highest set bit; x must be non-zero.
+    inline int highestSetBit(std::uint64_t x) {
+    #ifdef _MSC_VER
+        unsigned long i;
+        _BitScanReverse64(&i, x);
+        return static_cast<int>(i);
+    #else
+        return 63 - __builtin_clzll(x);
+    #endif
+    }
+
+    inline int popCount(std::uint64_t x) {
+    #ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(x));
+    #else
+        return __builtin_popcountll(x);
+    #endif
+    }
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+#include "Grid.h"
+#include "FlowField.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Hash map from (cell, tick) to an int, used for the reservations and for the
+// space-time search's seen set. Open addressing with linear probing over one
+// flat array of 16-byte entries, so a lookup usually touches one cache line;
+// entries carry a generation stamp, so clear() is O(1).
+class ReservationTable {
+public:
+    static constexpr int kNone = -1;
+
+    ReservationTable() { m_entries.resize(1024); }
+    void clear();
+    void set(CellId cell, int time, int value);
+    // The stored value, or kNone.
+    int get(CellId cell, int time) const;
+    std::size_t size() const { return m_count; }
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        std::int32_t value;
+        std::uint32_t stamp;
+    };
+
+    static std::uint64_t makeKey(CellId cell, int time) { return static_cast<std::uint64_t>(time) << 32 | cell.value; }
+    std::size_t home(std::uint64_t key) const { return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (m_entries.size() - 1); }
+    void grow();
+
+    std::vector<Entry> m_entries; // size is a power of two, at most half full
+    std::size_t m_count = 0;
+    std::uint32_t m_generation = 1;
+};
+
+struct AgentTask {
+    Point start;
+    Point goal;
+};
+
+// Vertex conflicts (two agents on one cell) plus swaps (two agents trading
+// cells) in the move from `before` to `after`.
+int countConflicts(const std::vector<Point>& before, const std::vector<Point>& after);
+
+// Cooperative A*: agents are planned one after another in space-time (a state
+// is a cell and a tick, and waiting is a move), each avoiding the cells and
+// swaps the earlier agents reserved. An agent that arrives parks on its goal
+// for good, so it may only finish once nobody is due to pass there later.
+// The heuristic is the exact distance from a FlowField per distinct goal.
+//
+// With a window, each plan covers only that many ticks and all agents are
+// replanned every window / 2 ticks (windowed hierarchical cooperative A*).
+// This bounds the search per plan and lets agents yield to later ones.
+// Agents still travelling are planned before those already on their goal, so
+// a parked agent steps aside rather than block the way. Either way, an agent
+// whose plan failed moves to the front of the order and everyone is replanned
+// on the next tick.
+//
+// Plans use the same 10/14 costs as the other searches (waiting costs 10), but
+// every action takes one tick. The grid must not change during a run.
+class CooperativePlanner {
+public:
+    // window <= 0 plans every agent to its goal once, before the first tick.
+    explicit CooperativePlanner(int window = 0) : m_window(window > 0 ? window : 0) {}
+
+    void reset(const Grid& grid, const std::vector<AgentTask>& agents);
+    // Moves every agent one tick, replanning first when due; returns the
+    // conflicts in that move.
+    int tick();
+    bool isFinished() const;
+
+    int getTime() const { return m_time; }
+    const std::vector<AgentTask>& getAgents() const { return m_agents; }
+    const std::vector<Point>& getPositions() const { return m_positions; }
+    double getPlanningMilliseconds() const { return m_planningMs; }
+    int getConflictCount() const { return m_conflicts; }
+    // Plans that found no path; the agent then waits where it is.
+    int getFailedPlanCount() const { return m_failedPlans; }
+
+private:
+    struct Node {
+        CellId cell;
+        int time;
+        int g;
+        int parent;
+    };
+    // Expansions one agent's search may use before it gives up.
+    static constexpr int kMaxExpansions = 200000;
+
+    void replan();
+    bool planAgent(int agent);
+    // Can agent move from `from` at tick t to `to` at t + 1 (to == from waits)?
+    bool isFree(int agent, CellId from, CellId to, int t) const;
+    void reserve(int agent, const std::vector<CellId>& plan);
+
+    int m_window;
+    const Grid* m_grid = nullptr;
+    std::vector<AgentTask> m_agents;
+    std::vector<Point> m_positions;
+    std::vector<std::unique_ptr<FlowField>> m_fields;
+    std::vector<int> m_fieldOf; // agent -> index into m_fields
+    std::vector<int> m_order;   // agents in planning order
+
+    // Plans hold one cell per tick from m_planStart; the last cell repeats.
+    std::vector<std::vector<CellId>> m_plans;
+    int m_planStart = 0;
+    int m_nextReplan = 0;
+    int m_time = 0;
+
+    ReservationTable m_reserved;
+    std::vector<int> m_lastReserved; // per cell: latest reserved tick, or -1
+    std::vector<int> m_parkedFrom;   // per cell: tick an agent parks there from
+    std::vector<int> m_parkedBy;
+
+    // Search scratch, reused across agents.
+    std::vector<Node> m_nodes;
+    ReservationTable m_seen;
+
+    double m_planningMs = 0.0;
+    int m_conflicts = 0;
+    int m_failedPlans = 0;
+};
\ No newline at end of file
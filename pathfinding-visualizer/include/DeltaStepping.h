@@ -0,0 +1,49 @@
+#pragma once
+#include "Grid.h"
+#include "ThreadPool.h"
+#include <functional>
+#include <vector>
+
+// Exact distances from source to every cell in 10/14 units, indexed by
+// CellId; SearchState::kInfinity for walls and unreachable cells. This is
+// plain sequential Dijkstra and serves as the reference for DeltaStepping.
+std::vector<int> computeDistances(const Grid& grid, CellId source);
+
+// Parallel single-source distances (Meyer and Sanders' delta-stepping).
+// Tentative distances sit in buckets of width delta; the lowest non-empty
+// bucket is settled in rounds in which all workers relax its light edges
+// (cost <= delta) at once, re-filling it until it stays empty. Heavy edges
+// are then relaxed once from every cell the bucket settled. Distances are
+// lowered with an atomic compare-and-swap, so the result equals
+// computeDistances() whatever the thread count.
+//
+// A wider delta means fewer buckets and bigger rounds, at the price of
+// relaxing some cells more than once. The default of one diagonal step makes
+// every edge light, so there is no heavy pass.
+class DeltaStepping {
+public:
+    // threads <= 0 uses one worker per hardware thread.
+    explicit DeltaStepping(int threads = 0, int delta = 14);
+
+    int getThreadCount() const { return m_pool.size(); }
+    int getDelta() const { return m_delta; }
+    // Rounds the last run needed; each one is a full pass over the pool.
+    long long getRoundCount() const { return m_rounds; }
+
+    // The grid is only read, and must not be edited during the call.
+    std::vector<int> run(const Grid& grid, CellId source);
+
+private:
+    // Hands out the cells of lists[0..workers) in chunks to every worker.
+    void forEachCell(const std::vector<std::vector<CellId>>& lists, const std::function<void(int, CellId)>& visit);
+
+    int m_delta;
+    ThreadPool m_pool;
+    long long m_rounds = 0;
+
+    // Per worker: a ring of buckets, the cells of the round being relaxed,
+    // and the cells settled in the current bucket.
+    std::vector<std::vector<std::vector<CellId>>> m_buckets;
+    std::vector<std::vector<CellId>> m_frontier;
+    std::vector<std::vector<CellId>> m_settled;
+};
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+
+// The eight move directions in the order used by Grid's successor masks and
+// neighbour offsets: N, S, W, E, NW, NE, SW, SE. Straight moves are 0-3.
+namespace dirs {
+    constexpr int kCount = 8;
+    constexpr int kDr[kCount] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    constexpr int kDc[kCount] = {0, 0, -1, 1, -1, 1, -1, 1};
+    constexpr int kOpposite[kCount] = {1, 0, 3, 2, 7, 6, 5, 4};
+
+    inline int index(int dr, int dc) {
+        static const int table[3][3] = {{4, 0, 5}, {2, -1, 3}, {6, 1, 7}};
+        return table[dr + 1][dc + 1];
+    }
+    inline unsigned bit(int dr, int dc) { return 1u << index(dr, dc); }
+    inline bool isDiagonal(int dir) { return dir >= 4; }
+    inline int sign(int v) { return (v > 0) - (v < 0); }
+
+    // Jump point search rule: does a cell with successor mask `open`, entered
+    // moving in direction dir, have a forced neighbour (a move that only
+    // becomes optimal because of an adjacent wall)?
+    inline bool hasForcedNeighbor(std::uint8_t open, int dir) {
+        int dr = kDr[dir], dc = kDc[dir];
+        if (dr != 0 && dc != 0) {
+            return (!(open & bit(0, -dc)) && (open & bit(dr, -dc))) ||
+                   (!(open & bit(-dr, 0)) && (open & bit(-dr, dc)));
+        }
+        // Straight move: look at both cells beside the current one.
+        int pr = dc, pc = dr;
+        return (!(open & bit(pr, pc)) && (open & bit(dr + pr, dc + pc))) ||
+               (!(open & bit(-pr, -pc)) && (open & bit(dr - pr, dc - pc)));
+    }
+}
\ No newline at end of file
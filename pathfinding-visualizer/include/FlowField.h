@@ -0,0 +1,48 @@
+#pragma once
+#include "Grid.h"
+#include "OpenList.h"
+#include <cstdint>
+#include <vector>
+
+// Shared routing towards one goal: a single reverse Dijkstra from the goal
+// gives every cell its distance and the direction of its next move, so any
+// number of agents can walk to the goal with one lookup per step.
+//
+// Edits are repaired locally. A new wall invalidates only the cells whose
+// directions led through it, which are re-seeded from their intact
+// neighbours; a removed wall is seeded from its neighbours and lets the
+// shorter distances spread. Either way the result matches a rebuild (up to
+// ties between equally short directions).
+class FlowField {
+public:
+    void build(const Grid& grid, const Point& goal);
+    // Call after grid.toggleWall(pos), like IPathfinder::onWallChanged.
+    void onWallChanged(const Point& pos);
+    bool isCurrent(const Grid& grid) const { return m_grid == &grid && m_version == grid.getVersion(); }
+
+    const Point& getGoal() const { return m_goal; }
+    // Next move (N, S, W, E, NW, NE, SW, SE order) towards the goal; -1 at
+    // the goal itself and wherever the goal cannot be reached.
+    int getDirection(CellId id) const { return m_direction[id.value]; }
+    // Path cost to the goal in 10/14 units; SearchState::kInfinity if unreachable.
+    int getDistance(CellId id) const { return m_distance[id.value]; }
+    // Where an agent at p moves next; p itself at the goal or when stuck.
+    Point next(const Point& p) const;
+
+private:
+    // Dijkstra from the cells already queued in m_open.
+    void propagate();
+    // Queues cell with its best distance through neighbours that still have one.
+    void seedFromNeighbors(CellId cell);
+
+    const Grid* m_grid = nullptr;
+    std::uint32_t m_version = 0;
+    Point m_goal = {-1, -1};
+    std::vector<int> m_distance;
+    std::vector<std::int8_t> m_direction;
+    BucketQueue m_open;
+    // Cells invalidated by the current wall insertion.
+    std::vector<std::uint32_t> m_mark;
+    std::uint32_t m_markGeneration = 0;
+    std::vector<CellId> m_affected;
+};
\ No newline at end of file
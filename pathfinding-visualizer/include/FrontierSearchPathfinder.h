@@ -0,0 +1,106 @@
+#pragma once
+#include "IPathfinder.h"
+#include "OpenList.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Divide-and-conquer bidirectional frontier search (Korf): neither a closed
+// list nor parents are kept, only the two open frontiers.
+//  - Each frontier cell remembers which of its moves lead back into the
+//    closed region (its used directions), so closed cells can be dropped the
+//    moment they are expanded and are never generated again.
+//  - Without parents the path comes from the meeting instead: the best
+//    meeting is an edge (a, b) of an optimal path, and the two halves S..a
+//    and b..E are solved the same way, down to single moves.
+//
+// Memory therefore follows the frontier rather than the visited area, at the
+// price of the extra searches on the halves. Both sides use octile distance
+// to the other end of the segment being solved, which keeps the cost optimal.
+// step() expands one cell; cells on either frontier of the current segment
+// show as visited.
+class FrontierSearchPathfinder : public IPathfinder {
+public:
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override { return "Frontier search (D&C)"; }
+    void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_peakOpen; }
+    double getSuboptimalityBound() const override { return 1.0; }
+    bool isVisitedFwd(CellId id) const override;
+    bool isVisitedBwd(CellId id) const override;
+
+    long long getExpansionCount() const { return m_expansions; }
+    // Bidirectional searches run so far, one per segment that needed one.
+    int getSearchCount() const { return m_searches; }
+    // Most frontier records held at once.
+    std::size_t getPeakFrontierSize() const { return m_peakRecords; }
+    // Record table, both queues and the segment stack at their largest.
+    std::size_t getPeakMemoryBytes() const;
+
+private:
+    static constexpr std::uint8_t kOpen[2] = {1, 2};
+    static constexpr std::uint8_t kClosed[2] = {4, 8};
+
+    // A cell on one or both frontiers; side 0 searches from the segment's
+    // start, side 1 from its end.
+    struct Record {
+        std::uint32_t cell;
+        std::uint32_t stamp; // live while it equals m_generation
+        int g[2];
+        std::uint8_t used[2]; // directions not to generate from this side
+        std::uint8_t flags;
+    };
+
+    // Part of the path still to be found; cost is -1 while unknown.
+    struct Segment {
+        CellId from;
+        CellId to;
+        int cost;
+    };
+
+    // Pops segments, emitting the trivial ones, until one needs a search.
+    void nextSegment();
+    void expand(int side);
+    // Smallest live f on a side, dropping stale queue entries on the way.
+    int topKey(int side);
+    int heuristic(CellId cell, CellId target) const;
+
+    Record* find(CellId cell);
+    const Record* find(CellId cell) const;
+    Record& insert(CellId cell);
+    void erase(CellId cell);
+    void grow();
+    std::size_t home(std::uint32_t cell) const { return (cell * 0x9E3779B1u >> 8) & (m_records.size() - 1); }
+
+    std::vector<Record> m_records; // power-of-two size, at most half full
+    std::size_t m_recordCount = 0;
+    std::uint32_t m_generation = 1;
+    // Lazy min-heaps of (f, cell); an entry is stale once the cell left that
+    // side's frontier or its f changed.
+    std::vector<PQElement> m_open[2];
+    std::size_t m_openCount[2] = {0, 0};
+
+    std::vector<Segment> m_segments;
+    Segment m_current = {};
+    bool m_searching = false;
+    bool m_done = false;
+    // Best meeting so far: the path runs from->...->m_meetA, m_meetB->...->to.
+    int m_meetCost = 0;
+    CellId m_meetA;
+    CellId m_meetB;
+    int m_meetCostA = 0;
+    int m_meetCostB = 0;
+
+    long long m_expansions = 0;
+    int m_searches = 0;
+    std::size_t m_peakOpen = 0;
+    std::size_t m_peakRecords = 0;
+    std::size_t m_peakTableBytes = 0;
+    std::size_t m_peakQueueBytes = 0;
+    std::size_t m_peakSegments = 0;
+
+    Point m_start;
+    Point m_end;
+};
\ No newline at end of file
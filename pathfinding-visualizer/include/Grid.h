@@ -1,5 +1,7 @@
 #pragma once
 #include "Point.h"
+#include "AlignedAllocator.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <random>
@@ -12,24 +14,91 @@ public:
     int getCols() const { return cols; }
     Point getStart() const { return start_pos; }
     Point getEnd() const { return end_pos; }
-    const Node& getNode(int r, int c) const;
-    Node& getNode(int r, int c);
-    const Point& getCurrentlyProcessing() const { return currently_processing; }
+
+    // Terrain only: per-search data lives in each pathfinder's SearchState.
+    // Nodes live in one row-major buffer surrounded by a one-cell ring of
+    // permanent walls, so every logical cell has 8 addressable neighbours.
+    // CellIds address the padded buffer; (r, c) stay logical.
+    int getStride() const { return stride; }
+    int getCellCount() const { return (rows + 2) * stride; }
+    CellId index(int r, int c) const { return CellId(static_cast<std::uint32_t>((r + 1) * stride + (c + 1))); }
+    CellId index(const Point& p) const { return index(p.first, p.second); }
+    Point toPoint(CellId id) const { return {static_cast<int>(id.value) / stride - 1, static_cast<int>(id.value) % stride - 1}; }
+    // Index delta to the neighbour in direction dir (N, S, W, E, NW, NE, SW, SE).
+    int getNeighborOffset(int dir) const { return neighbor_offsets[dir]; }
+
+    const Node& getNode(CellId id) const { return grid_data[id.value]; }
+    const Node& getNode(int r, int c) const { return getNode(index(r, c)); }
     
+    // Walls are mirrored into a dense bitmap (bit i = cell i) for word-level queries.
+    bool isWall(CellId id) const { return (wall_bits[id.value >> 6] >> (id.value & 63)) & 1; }
+    // Successor mask: bit i is set when the neighbour in direction i is not a
+    // wall (always 0 for walls). Kept per cell and patched locally on edits.
+    std::uint8_t getNeighborMask(CellId id) const { return neighbor_masks[id.value]; }
+    // Wall bits of cells pos .. pos+63 (bit k = cell pos+k); cells outside the buffer read as walls.
+    std::uint64_t getWallWord(int pos) const;
+    // Column of the first wall in [c_begin, c_end) of row r, or c_end if there is none.
+    int findFirstWall(int r, int c_begin, int c_end) const;
+    // Straight line between two cell centres, rasterised to the nearest cell
+    // across its major axis, so consecutive cells are 8-neighbours. It is
+    // clear when none of those cells is a wall; each row of a shallow line is
+    // one findFirstWall scan.
+    bool hasLineOfSight(const Point& a, const Point& b) const;
+    // Appends the line's cells from a to b, both included.
+    void appendLine(const Point& a, const Point& b, std::vector<Point>& out) const;
+
+    // JPS+ table, built on request and then kept in sync by every edit. Entry
+    // (cell, dir) > 0: a jump point lies that many steps away in direction dir.
+    // Entry <= 0: no jump point; -entry open cells precede the next wall.
+    // Goal-specific jump points are not included; searches add them.
+    void buildJumpTable();
+    bool hasJumpTable() const { return !jump_table.empty(); }
+    int getJumpDistance(CellId id, int dir) const { return jump_table[static_cast<size_t>(id.value) * 8 + dir]; }
+
     bool isValid(int r, int c) const;
+    void createMazeFromLayout(const std::vector<std::string>& layout);
     void generateMaze();
-    void reset();
     void toggleWall(const Point& pos);
-    void setCurrentlyProcessing(const Point& pos);
-    std::vector<Point> reconstructPath(bool isBidirectional = false, Point meetingPoint = {-1,-1});
+    // Connected components of open cells (8-connected, like the searches).
+    // Labels are kept current by every edit; walls have no component.
+    static constexpr std::uint32_t kNoComponent = 0xFFFFFFFFu;
+    std::uint32_t getComponent(CellId id) const;
+    bool isReachable(CellId a, CellId b) const;
+
+    // Bumped by every terrain change, so data derived from the grid can tell
+    // whether it is stale.
+    std::uint32_t getVersion() const { return version; }
 
 private:
+    Node& nodeAt(CellId id) { return grid_data[id.value]; }
+    void setWall(CellId id, bool wall);
+    std::uint8_t computeNeighborMask(CellId id) const;
+    void rebuildNeighborMasks();
+    void rebuildComponents();
+    std::uint32_t newComponent();
+    std::uint32_t findComponent(std::uint32_t label) const;
+    std::uint32_t uniteComponents(std::uint32_t a, std::uint32_t b);
+    void splitComponents(CellId removed, std::uint8_t ringOpen);
+    int computeJumpDistance(CellId id, int dir) const;
+    void repairJumpTable(CellId changed);
     void carvePath(int r, int c, std::mt19937& rng);
 
     int rows;
     int cols;
-    std::vector<std::vector<Node>> grid_data;
+    int stride;
+    int neighbor_offsets[8];
+    std::vector<Node, AlignedAllocator<Node>> grid_data;
+    std::vector<std::uint64_t, AlignedAllocator<std::uint64_t>> wall_bits;
+    std::vector<std::uint8_t, AlignedAllocator<std::uint8_t>> neighbor_masks;
+    std::vector<std::int32_t, AlignedAllocator<std::int32_t>> jump_table;
+    // Per-cell label plus a union-find forest over labels (union by rank,
+    // no path compression, so lookups never write). The first kFloodLabels
+    // labels are scratch for splitComponents and never left on a cell.
+    static constexpr std::uint32_t kFloodLabels = 8;
+    std::vector<std::uint32_t> component_label;
+    std::vector<std::uint32_t> component_parent;
+    std::vector<std::uint8_t> component_rank;
     Point start_pos;
     Point end_pos;
-    Point currently_processing = {-1, -1};
+    std::uint32_t version = 0;
 };
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+#include "IPathfinder.h"
+#include "OpenList.h"
+
+// HPA*: the grid is cut into square clusters and an abstract graph is built
+// over their entrances (cells where a path can cross into a neighbouring
+// cluster), with the costs between entrances of one cluster precomputed.
+// A second level groups superSize x superSize clusters into super-clusters
+// and does the same with the entrances on their borders, using the first
+// level's graph inside each super-cluster.
+//
+// A query connects start and goal to the entrances of their clusters and
+// super-clusters, searches the top graph (one step() expands one top-level
+// node) and refines each edge twice: first into first-level entrances with a
+// search confined to one super-cluster, then into cells with a search
+// confined to one cluster. Every first-level path between super-clusters
+// passes through top-level nodes, so the second level by itself leaves the
+// cost as it was. The top search inflates its heuristic slightly, which keeps
+// it from sweeping a band of near ties on long queries; paths are
+// near-optimal, not optimal.
+//
+// The abstraction is built on the first init() for a grid; afterwards
+// onWallChanged() rebuilds only the clusters around the edited cell, and the
+// super-clusters holding those whose entrances or costs changed.
+class HierarchicalPathfinder : public IPathfinder {
+public:
+    explicit HierarchicalPathfinder(int clusterSize = 16, int superSize = 4);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override;
+    void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_peakOpen; }
+
+    std::size_t getAbstractNodeCount() const;
+    // Nodes of the top-level graph, the one step() searches.
+    std::size_t getSuperNodeCount() const;
+
+private:
+    struct Crossing {
+        CellId cell; // entrance on the other side of the border
+        int cost;
+    };
+    struct Cluster {
+        int row0, col0, rows, cols;
+        std::vector<CellId> entrances;
+        std::vector<std::vector<Crossing>> crossings; // per entrance
+        std::vector<int> distances; // entrance x entrance, row-major
+    };
+    struct Edge {
+        int node;
+        int cost;
+    };
+    // A block of clusters. Its searches number the entrances of the member
+    // clusters as nodes, cluster by cluster in row-major order, and follow
+    // the edges of the first-level graph that stay inside the block.
+    struct SuperCluster {
+        int clusterRow0, clusterCol0, clusterRows, clusterCols;
+        std::vector<CellId> nodes;
+        std::vector<int> firstNode;    // per member cluster: its first node
+        std::vector<int> firstEdge;    // node i's edges are edges[firstEdge[i] .. firstEdge[i + 1])
+        std::vector<Edge> edges;
+        std::vector<CellId> entrances; // nodes with a crossing out of the block
+        std::vector<int> distances;    // entrance x entrance, row-major
+        std::vector<char> rowReady;    // per entrance: its row of distances is filled
+    };
+
+    void buildAbstraction();
+    void buildCluster(int id);
+    // Rebuilds the block's nodes, edges and entrances. With fillRows, also
+    // every row of distances; otherwise rows wait for distanceRow().
+    void buildSuperCluster(int id, bool fillRows);
+    const int* distanceRow(int id, int slot);
+    void addStraightEntrances(Cluster& cluster, Point first, int alongDir, int outDir, int length);
+    void addEntrance(Cluster& cluster, CellId inside, CellId outside, int cost);
+    int clusterOf(const Point& p) const;
+    // Slot of the cell among its cluster's entrances, or -1.
+    int entranceSlot(CellId cell) const { return m_entranceSlot[cell.value]; }
+    void searchCluster(const Cluster& cluster, CellId source, bool keepParents, const std::vector<int>* targets = nullptr) const;
+    int localIndex(const Cluster& cluster, const Point& p) const;
+    int superOf(int clusterId) const;
+    // Gives the super-clusters' entrances consecutive top-level ids.
+    void numberTopNodes();
+    int nodeIndex(const SuperCluster& super, CellId cell) const;
+    // Seeds for a super-cluster search from a cell, given its costs to each
+    // entrance of its cluster.
+    std::vector<std::pair<int, int>> seedsFrom(int clusterId, const std::vector<int>& costs) const;
+    void searchSuperCluster(int id, const std::vector<std::pair<int, int>>& seeds,
+                            const std::vector<int>* targets = nullptr, CellId toward = CellId::invalid()) const;
+    // Cheapest way into the goal after a search of the goal's super-cluster:
+    // the node it leaves from (-1 if none), with the total cost in `cost`.
+    int bestGoalNode(int& cost) const;
+    void startQuery();
+    // Appends the first-level route from `from` to `to`, both in one
+    // super-cluster, leaving out `from` itself.
+    void appendRoute(CellId from, CellId to, std::vector<CellId>& route) const;
+    void refinePath();
+    int heuristic(const Point& a, const Point& b) const;
+    // Keys ordered by f, ties going to the larger g.
+    std::uint64_t calculateKey(int id, int g) const;
+
+    int m_clusterSize;
+    int m_superSize; // clusters per super-cluster side
+    std::string m_name;
+    int m_clusterRows = 0;
+    int m_clusterCols = 0;
+    std::vector<Cluster> m_clusters;
+    std::vector<int> m_entranceSlot; // per cell, see entranceSlot()
+    int m_superRows = 0;
+    int m_superCols = 0;
+    std::vector<SuperCluster> m_supers;
+    // Top-level nodes are numbered super-cluster by super-cluster; the two
+    // ids after them stand for the current start and goal.
+    std::vector<int> m_superBase;   // per super-cluster: id of its first entrance
+    std::vector<int> m_topId;       // per cell, or -1
+    std::vector<CellId> m_topCells; // per id
+    int m_startId = 0;
+    int m_goalId = 1;
+    const Grid* m_builtFor = nullptr;
+    std::uint32_t m_builtVersion = 0;
+
+    // The top-level search keeps its own state by id, which stays small and
+    // contiguous where m_state would spread it over the whole map. m_state
+    // only records expanded cells, for display. Entries are current while
+    // their stamp equals m_topGeneration.
+    std::vector<std::uint32_t> m_topStamp;
+    std::uint32_t m_topGeneration = 0;
+    std::vector<int> m_topG;
+    std::vector<int> m_topParent;
+    std::vector<char> m_topClosed;
+    IndexedDaryHeap<4> m_open;
+    std::size_t m_peakOpen = 0;
+    Point m_start;
+    Point m_end;
+    CellId m_startCell;
+    CellId m_endCell;
+    int m_startCluster = 0;
+    int m_endCluster = 0;
+    std::vector<int> m_startCosts; // start -> each entrance of its cluster
+    std::vector<int> m_goalCosts;  // each entrance of the goal's cluster -> goal
+    int m_directCost = SearchState::kInfinity; // inside a shared cluster
+    int m_startSuper = 0;
+    int m_endSuper = 0;
+    std::vector<int> m_superStartCosts; // start -> each entrance of its super-cluster
+    std::vector<int> m_superGoalCosts;  // each entrance of the goal's super-cluster -> goal
+    int m_superDirectCost = SearchState::kInfinity; // inside a shared super-cluster
+
+    // Scratch for searchCluster(), indexed by cluster-local cell.
+    static const int kLocalBuckets = 15;
+    mutable std::vector<int> m_localDist;
+    mutable std::vector<int> m_localParent;
+    mutable std::vector<int> m_localBuckets[kLocalBuckets];
+    mutable std::vector<char> m_localIsTarget;
+    // Scratch for searchSuperCluster(), indexed by node.
+    mutable std::vector<int> m_superDist;
+    mutable std::vector<int> m_superParent; // -1 for a seed
+    mutable std::vector<char> m_superIsTarget;
+    mutable std::vector<PQElement> m_superOpen;
+};
\ No newline at end of file
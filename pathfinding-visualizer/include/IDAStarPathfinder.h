@@ -0,0 +1,91 @@
+#pragma once
+#include "IPathfinder.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Memory-bounded search for maps whose per-cell arrays would not fit: IDA*
+// runs depth-first passes under a growing f = g + h threshold and only keeps
+// the current path on a stack. A transposition table of fixed size backs it:
+//  - an 8-connected grid has a huge number of equal-cost routes to every
+//    cell, so the table remembers the smallest g each cell was entered with
+//    during the current pass and cuts the duplicates;
+//  - when a cell's subtree is done, it stores min(step + h) over the cell's
+//    neighbours as the cell's h. That stays admissible and lets later passes
+//    stop at once where an earlier pass found no way through.
+// When the table is full, entries are overwritten; a lost entry falls back
+// to octile distance, which costs re-expansions but never optimality.
+//
+// m_state stays empty; the memory used is the table plus a stack as deep as
+// the path being explored. Open maps suit it; in a maze octile distance is
+// far too low and the threshold creeps up over thousands of passes.
+class IDAStarPathfinder : public IPathfinder {
+public:
+    // memoryBytes is the size of the transposition table.
+    explicit IDAStarPathfinder(std::size_t memoryBytes = 1 << 20);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override;
+    void onWallChanged(const Point& pos) override;
+    double getSuboptimalityBound() const override { return 1.0; }
+    // Cells the table holds for the current pass.
+    bool isVisitedFwd(CellId id) const override;
+    bool isVisitedBwd(CellId) const override { return false; }
+
+    long long getExpansionCount() const { return m_expansions; }
+    int getIterationCount() const { return m_pass; }
+    // Table plus the deepest the stack has been during this search.
+    std::size_t getPeakMemoryBytes() const;
+
+private:
+    struct Entry {
+        std::uint32_t cell; // 0, a border cell, marks an empty slot
+        std::uint32_t g;    // smallest g this pass, valid while pass matches
+        std::uint32_t pass;
+        std::uint32_t h;    // learned, kept across passes
+    };
+    static constexpr int kWays = 4; // entries per bucket
+
+    // A cell on the current path and the neighbours still to try from it,
+    // best f first.
+    struct Frame {
+        CellId cell;
+        int g;
+        std::uint8_t next;
+        std::uint8_t count;
+        std::uint8_t dirs[8];
+    };
+
+    int heuristic(CellId cell) const;
+    // Learned h if the table still has it, octile distance otherwise.
+    int lookupH(CellId cell) const;
+    // Pushes cell, sorting its neighbours within the threshold by f and
+    // lowering m_nextThreshold to the smallest f beyond it.
+    void enter(CellId cell, int g);
+    // Pops the top cell and stores its backed-up h.
+    void leave();
+    // True if the cell was already entered this pass with g or less;
+    // otherwise records g for it.
+    bool checkAndRecord(CellId cell, int g);
+    const Entry* find(CellId cell) const;
+    // The cell's entry, evicting another one if it has none.
+    Entry& slot(CellId cell);
+
+    std::size_t m_memoryBytes;
+    std::vector<Entry> m_table;
+    std::size_t m_bucketMask = 0;
+
+    std::vector<Frame> m_stack;
+    std::size_t m_peakDepth = 0;
+    int m_threshold = 0;
+    int m_nextThreshold = 0;
+    std::uint32_t m_pass = 0;
+    long long m_expansions = 0;
+    bool m_done = false;
+
+    Point m_start;
+    Point m_end;
+    CellId m_startCell;
+    CellId m_endCell;
+};
\ No newline at end of file
@@ -1,21 +1,53 @@
 #pragma once
 #include "Grid.h"
+#include "SearchState.h"
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <vector>
 
 enum class AlgoState { Running, PathFound, PathNotFound, Paused };
 
+// Cost of a cell path under the 10/14 straight/diagonal model.
+inline int pathCost(const std::vector<Point>& path) {
+    int cost = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        bool diagonal = path[i].first != path[i - 1].first && path[i].second != path[i - 1].second;
+        cost += diagonal ? 14 : 10;
+    }
+    return cost;
+}
+
 class IPathfinder {
 public:
     virtual ~IPathfinder() = default;
-    virtual void init(Grid& grid) = 0;
+    // Starts a search between the grid's own start and end cells.
+    void init(const Grid& grid) { init(grid, grid.getStart(), grid.getEnd()); }
+    // Starts a search between any two cells; the grid is only read, so
+    // several pathfinders may search one grid from different threads.
+    virtual void init(const Grid& grid, const Point& start, const Point& end) = 0;
     virtual AlgoState step() = 0;
     virtual std::string getName() const = 0;
     virtual void onWallChanged(const Point& pos) = 0;
-    Grid& getGrid() { return *m_grid; }
+    // Largest number of entries the open list(s) held during the current search.
+    virtual std::size_t getPeakOpenSize() const { return 0; }
+    // Proven ratio between the cost of getPath() and the optimal cost:
+    // infinity (no guarantee) by default, 1 for searches that are exact, and
+    // the current bound for anytime searches, so a caller can stop stepping
+    // once it is good enough.
+    virtual double getSuboptimalityBound() const { return std::numeric_limits<double>::infinity(); }
+    // Visit flags the visualizer colours by; pathfinders that keep them
+    // outside m_state override these.
+    virtual bool isVisitedFwd(CellId id) const { return m_state.isVisitedFwd(id); }
+    virtual bool isVisitedBwd(CellId id) const { return m_state.isVisitedBwd(id); }
+    const Grid& getGrid() const { return *m_grid; }
+    const SearchState& getSearchState() const { return m_state; }
+    const Point& getCurrentlyProcessing() const { return m_currentlyProcessing; }
     const std::vector<Point>& getPath() const { return m_path; }
 
 protected:
-    Grid* m_grid = nullptr;
+    const Grid* m_grid = nullptr;
+    SearchState m_state;
+    Point m_currentlyProcessing = {-1, -1};
     std::vector<Point> m_path;
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include "IPathfinder.h"
+#include "OpenList.h"
+
+// Jump Point Search for the uniform 10/14 cost, 8-connected grid (diagonal
+// moves may cut corners, as in AStarPathfinder). Symmetric successors are
+// pruned and the search jumps along straight and diagonal lines, so only
+// jump points enter the open list. Each step() expands one jump point.
+// With `precomputed` set (JPS+) jumps are read from the Grid's jump table,
+// which the owner must build with Grid::buildJumpTable().
+class JumpPointSearchPathfinder : public IPathfinder {
+public:
+    JumpPointSearchPathfinder(bool precomputed = false, OpenListKind openList = OpenListKind::LazyBinaryHeap);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override;
+    void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_open.getPeakSize(); }
+    double getSuboptimalityBound() const override { return 1.0; }
+
+private:
+    int heuristic(const Point& a, const Point& b) const;
+    std::uint8_t prunedDirections(CellId cell, int dr, int dc) const;
+    CellId jump(CellId from, int dir) const;
+    CellId jumpPrecomputed(CellId from, int dir) const;
+    CellId jumpStraight(CellId from, int dir) const;
+    CellId jumpEast(CellId from) const;
+    CellId jumpWest(CellId from) const;
+    std::vector<Point> expandPath(const std::vector<Point>& jumpPoints) const;
+
+    bool m_precomputed;
+    bool m_useTable = false;
+    std::string m_name;
+    OpenList m_open;
+    Point m_start;
+    Point m_end;
+    CellId m_endCell;
+};
\ No newline at end of file
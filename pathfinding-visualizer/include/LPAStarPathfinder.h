@@ -0,0 +1,38 @@
+#pragma once
+#include "IPathfinder.h"
+#include "OpenList.h"
+
+// Lifelong Planning A*: an incremental planner for a fixed start and goal.
+// g and rhs (the one-step lookahead of g) survive wall edits, so
+// onWallChanged() only re-queues the cells next to the edit and the next
+// steps repair just the part of the search the edit actually affects.
+// Uses the 10/14 cost model with corner cutting and the octile heuristic.
+class LPAStarPathfinder : public IPathfinder {
+public:
+    LPAStarPathfinder();
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override;
+    void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_peakOpen; }
+    double getSuboptimalityBound() const override { return 1.0; }
+
+private:
+    int heuristic(CellId cell) const;
+    std::uint64_t calculateKey(CellId cell) const;
+    int bestPredecessorCost(CellId cell) const;
+    void updateVertex(CellId cell);
+    void extractPath();
+
+    std::string m_name;
+    IndexedDaryHeap<4> m_open;
+    std::size_t m_peakOpen = 0;
+    // Persistent across edits, unlike the generation-stamped SearchState,
+    // which here only records what the current (re)plan has expanded.
+    std::vector<int> m_g;
+    std::vector<int> m_rhs;
+    CellId m_startCell;
+    CellId m_endCell;
+    Point m_end;
+};
\ No newline at end of file
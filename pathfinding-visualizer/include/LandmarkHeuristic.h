@@ -0,0 +1,34 @@
+#pragma once
+#include "Grid.h"
+#include <cstdint>
+#include <vector>
+
+// ALT (A*, landmarks, triangle inequality) lower bounds. For a landmark L
+// and exact distances d, |d(L, b) - d(L, a)| <= d(a, b) on this undirected
+// grid, so the best bound over a few well spread landmarks is admissible and
+// follows corridors that straight-line estimates cannot see.
+//
+// Tables are built for one terrain version. Walls added afterwards only
+// lengthen paths, so old bounds stay admissible; callers should still
+// rebuild after edits, as removed walls can make them overestimate.
+class LandmarkHeuristic {
+public:
+    explicit LandmarkHeuristic(int count = 8) : m_count(count) {}
+
+    // Picks landmarks by farthest-point selection in the start's component
+    // and runs one Dijkstra per landmark.
+    void build(const Grid& grid);
+    bool isCurrent(const Grid& grid) const { return m_grid == &grid && m_version == grid.getVersion(); }
+
+    // Max of the landmark bounds and the octile distance, in 10/14 units.
+    int estimate(CellId from, CellId to) const;
+
+    const std::vector<CellId>& getLandmarks() const { return m_landmarks; }
+
+private:
+    int m_count;
+    const Grid* m_grid = nullptr;
+    std::uint32_t m_version = 0;
+    std::vector<CellId> m_landmarks;
+    std::vector<std::vector<int>> m_distances; // one table per landmark, by CellId
+};
\ No newline at end of file
@@ -0,0 +1,393 @@
+#pragma once
+#include "Bits.h"
+#include "Point.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Open-list entries pack (priority, cell) into one 64-bit integer: the
+// priority sits in the high half and the CellId in the low half, so a heap
+// comparison is a single integer compare and ties still break by row-major
+// position, as the old std::pair<int, Point> entries did.
+using PQElement = std::uint64_t;
+
+inline PQElement makePQElement(int priority, CellId cell) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(priority)) << 32 | cell.value;
+}
+inline int getPriority(PQElement e) { return static_cast<int>(e >> 32); }
+inline CellId getCell(PQElement e) { return CellId(static_cast<std::uint32_t>(e)); }
+
+using LazyPriorityQueue = std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>>;
+
+// Min-heap with arity D that remembers where every cell sits, so a cell is
+// stored at most once and its key can be changed in place (decrease-key).
+// Keys are compared first, then CellIds.
+template <unsigned D = 4>
+class IndexedDaryHeap {
+public:
+    struct Entry {
+        std::uint64_t key;
+        CellId cell;
+    };
+
+    // Sizes the position table; only cells still in the heap are cleared.
+    void reset(int cellCount) {
+        for (const Entry& e : m_heap) m_pos[e.cell.value] = kNotInHeap;
+        m_heap.clear();
+        m_pos.resize(cellCount, kNotInHeap);
+    }
+
+    bool empty() const { return m_heap.empty(); }
+    std::size_t size() const { return m_heap.size(); }
+    bool contains(CellId cell) const { return m_pos[cell.value] != kNotInHeap; }
+    // The heap never gives back capacity, so this covers its peak too.
+    std::size_t getMemoryBytes() const { return m_heap.capacity() * sizeof(Entry) + m_pos.capacity() * sizeof(std::uint32_t); }
+    const Entry& top() const { return m_heap.front(); }
+
+    // Inserts the cell, or moves it to its new key if it is already queued.
+    void push(CellId cell, std::uint64_t key) {
+        std::uint32_t i = m_pos[cell.value];
+        if (i == kNotInHeap) {
+            m_heap.push_back({key, cell});
+            siftUp(static_cast<std::uint32_t>(m_heap.size() - 1));
+        } else if (key < m_heap[i].key) {
+            m_heap[i].key = key;
+            siftUp(i);
+        } else if (m_heap[i].key < key) {
+            m_heap[i].key = key;
+            siftDown(i);
+        }
+    }
+
+    void pop() { removeAt(0); }
+
+    void remove(CellId cell) {
+        std::uint32_t i = m_pos[cell.value];
+        if (i != kNotInHeap) removeAt(i);
+    }
+
+private:
+    static const std::uint32_t kNotInHeap = 0xFFFFFFFFu;
+
+    static bool less(const Entry& a, const Entry& b) {
+        return a.key < b.key || (a.key == b.key && a.cell < b.cell);
+    }
+
+    void place(std::uint32_t i, const Entry& e) {
+        m_heap[i] = e;
+        m_pos[e.cell.value] = i;
+    }
+
+    void removeAt(std::uint32_t i) {
+        m_pos[m_heap[i].cell.value] = kNotInHeap;
+        Entry last = m_heap.back();
+        m_heap.pop_back();
+        if (i == m_heap.size()) return;
+        place(i, last);
+        siftUp(i);
+        siftDown(m_pos[last.cell.value]);
+    }
+
+    void siftUp(std::uint32_t i) {
+        Entry e = m_heap[i];
+        while (i > 0) {
+            std::uint32_t parent = (i - 1) / D;
+            if (!less(e, m_heap[parent])) break;
+            place(i, m_heap[parent]);
+            i = parent;
+        }
+        place(i, e);
+    }
+
+    void siftDown(std::uint32_t i) {
+        Entry e = m_heap[i];
+        std::uint32_t n = static_cast<std::uint32_t>(m_heap.size());
+        while (true) {
+            std::uint32_t first = i * D + 1;
+            if (first >= n) break;
+            std::uint32_t last = first + D < n ? first + D : n;
+            std::uint32_t best = first;
+            for (std::uint32_t c = first + 1; c < last; ++c) {
+                if (less(m_heap[c], m_heap[best])) best = c;
+            }
+            if (!less(m_heap[best], e)) break;
+            place(i, m_heap[best]);
+            i = best;
+        }
+        place(i, e);
+    }
+
+    std::vector<Entry> m_heap;
+    std::vector<std::uint32_t> m_pos;
+};
+
+template <unsigned D>
+const std::uint32_t IndexedDaryHeap<D>::kNotInHeap;
+
+// Dial-style bucket queue for small integer priorities such as the 10/14
+// cost model. Buckets form a ring indexed by priority & mask; the ring doubles
+// whenever the live priorities span more buckets than it has, so keys may
+// also fall below the current minimum (the Manhattan heuristic is not
+// consistent on 8-connected moves). A bitmap of non-empty buckets lets the
+// cursor skip 64 empty ones at a time. Each cell is queued at most once.
+//
+// Within a bucket, cells come out largest tie value first, then smallest
+// CellId. A* passes g, so equal-f plateaus are crossed depth-first instead of
+// flooded, and otherwise ties go the way the heaps break them. Each bucket is
+// a small binary heap in that order, so push, pop and remove cost
+// O(log bucket size). A tie of 0 means no preference: such cells are not
+// ordered among themselves, which keeps those operations O(1).
+class BucketQueue {
+public:
+    void reset(int cellCount) {
+        for (auto& bucket : m_buckets) {
+            for (CellId cell : bucket) m_cells[cell.value].slot = kNotQueued;
+            bucket.clear();
+        }
+        if (m_buckets.empty()) {
+            m_buckets.resize(64);
+            m_occupied.assign(1, 0);
+        }
+        std::fill(m_occupied.begin(), m_occupied.end(), 0);
+        m_cells.resize(cellCount, Cell{kNotQueued, 0, 0});
+        m_count = 0;
+    }
+
+    bool empty() const { return m_count == 0; }
+    std::size_t size() const { return m_count; }
+    int topKey() const { return m_minKey; }
+
+    void push(CellId cell, int key, int tie = 0) {
+        Cell& c = m_cells[cell.value];
+        if (c.slot != kNotQueued) {
+            if (c.key == key && c.tie == tie) return;
+            remove(cell);
+        }
+        if (m_count == 0) {
+            m_minKey = m_maxKey = key;
+        } else {
+            if (key < m_minKey) m_minKey = key;
+            if (key > m_maxKey) m_maxKey = key;
+        }
+        if (static_cast<std::size_t>(m_maxKey - m_minKey) >= m_buckets.size()) grow();
+
+        std::size_t b = static_cast<std::size_t>(key & mask());
+        std::vector<CellId>& bucket = m_buckets[b];
+        c.key = key;
+        c.tie = tie;
+        bucket.push_back(cell);
+        if (bucket.size() == 1) m_occupied[b >> 6] |= 1ULL << (b & 63);
+        siftUp(bucket, static_cast<std::uint32_t>(bucket.size() - 1));
+        ++m_count;
+    }
+
+    CellId pop() {
+        CellId cell = m_buckets[m_minKey & mask()].front();
+        removeAt(static_cast<std::size_t>(m_minKey & mask()), 0);
+        return cell;
+    }
+
+    void remove(CellId cell) {
+        const Cell& c = m_cells[cell.value];
+        removeAt(static_cast<std::size_t>(c.key & mask()), c.slot);
+    }
+
+private:
+    enum : std::uint32_t { kNotQueued = 0xFFFFFFFFu };
+
+    // Everything the queue knows about a cell, kept together so that a push
+    // touches one cache line.
+    struct Cell {
+        std::uint32_t slot; // position in its bucket, or kNotQueued
+        int key;
+        int tie;
+    };
+
+    int mask() const { return static_cast<int>(m_buckets.size()) - 1; }
+
+    void removeAt(std::size_t b, std::uint32_t slot) {
+        std::vector<CellId>& bucket = m_buckets[b];
+        m_cells[bucket[slot].value].slot = kNotQueued;
+        CellId moved = bucket.back();
+        bucket.pop_back();
+        if (slot < bucket.size()) {
+            bucket[slot] = moved;
+            m_cells[moved.value].slot = slot;
+            siftUp(bucket, slot);
+            siftDown(bucket, m_cells[moved.value].slot);
+        } else if (bucket.empty()) {
+            m_occupied[b >> 6] &= ~(1ULL << (b & 63));
+        }
+        --m_count;
+        advance();
+    }
+
+    bool before(CellId a, CellId b) const {
+        int ta = m_cells[a.value].tie, tb = m_cells[b.value].tie;
+        return ta > tb || (ta == tb && ta != 0 && a < b);
+    }
+
+    // Heap on before() within one bucket; slots follow every move.
+    void siftUp(std::vector<CellId>& bucket, std::uint32_t i) {
+        CellId cell = bucket[i];
+        while (i > 0) {
+            std::uint32_t parent = (i - 1) / 2;
+            if (!before(cell, bucket[parent])) break;
+            bucket[i] = bucket[parent];
+            m_cells[bucket[i].value].slot = i;
+            i = parent;
+        }
+        bucket[i] = cell;
+        m_cells[cell.value].slot = i;
+    }
+
+    void siftDown(std::vector<CellId>& bucket, std::uint32_t i) {
+        CellId cell = bucket[i];
+        std::uint32_t n = static_cast<std::uint32_t>(bucket.size());
+        while (true) {
+            std::uint32_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && before(bucket[child + 1], bucket[child])) ++child;
+            if (!before(bucket[child], cell)) break;
+            bucket[i] = bucket[child];
+            m_cells[bucket[i].value].slot = i;
+            i = child;
+        }
+        bucket[i] = cell;
+        m_cells[cell.value].slot = i;
+    }
+
+    // Moves the cursor to the lowest non-empty bucket; every live key lies
+    // within one ring length of m_minKey, so the first hit going round the
+    // ring is the minimum.
+    void advance() {
+        if (m_count == 0) {
+            m_maxKey = m_minKey;
+            return;
+        }
+        std::size_t from = static_cast<std::size_t>(m_minKey & mask());
+        std::size_t word = from >> 6;
+        std::uint64_t bits = m_occupied[word] & (~0ULL << (from & 63));
+        while (!bits) {
+            word = (word + 1) & (m_occupied.size() - 1);
+            bits = m_occupied[word];
+        }
+        std::size_t found = word << 6 | static_cast<std::size_t>(bits::countTrailingZeros(bits));
+        m_minKey += static_cast<int>((found - from) & static_cast<std::size_t>(mask()));
+    }
+
+    void grow() {
+        std::size_t needed = static_cast<std::size_t>(m_maxKey - m_minKey) + 1;
+        std::size_t newSize = m_buckets.size();
+        while (newSize < needed) newSize *= 2;
+        std::vector<std::vector<CellId>> old(newSize);
+        old.swap(m_buckets);
+        m_occupied.assign(newSize / 64, 0);
+        // A bucket keeps its heap order, as all its keys land in one new bucket.
+        for (auto& bucket : old) {
+            if (bucket.empty()) continue;
+            std::size_t b = static_cast<std::size_t>(m_cells[bucket.front().value].key & mask());
+            m_buckets[b].swap(bucket);
+            m_occupied[b >> 6] |= 1ULL << (b & 63);
+        }
+    }
+
+    std::vector<std::vector<CellId>> m_buckets; // size is a power of two, at least 64
+    std::vector<std::uint64_t> m_occupied;      // one bit per bucket
+    std::vector<Cell> m_cells;
+    std::size_t m_count = 0;
+    int m_minKey = 0;
+    int m_maxKey = 0;
+};
+
+enum class OpenListKind { LazyBinaryHeap, IndexedDaryHeap, BucketQueue };
+
+// Suffix appended to a pathfinder's display name; empty for the default.
+inline const char* getOpenListLabel(OpenListKind kind) {
+    switch (kind) {
+        case OpenListKind::IndexedDaryHeap: return " (4-ary heap)";
+        case OpenListKind::BucketQueue: return " (bucket queue)";
+        default: return "";
+    }
+}
+
+// The open list used by AStarPathfinder and BidirectionalPathfinder.
+// LazyBinaryHeap pushes a duplicate on every improvement and relies on the
+// caller's visited check to drop stale entries; IndexedDaryHeap and
+// BucketQueue keep one entry per cell and decrease its key instead.
+class OpenList {
+public:
+    explicit OpenList(OpenListKind kind = OpenListKind::LazyBinaryHeap) : m_kind(kind) {}
+
+    OpenListKind getKind() const { return m_kind; }
+    std::size_t getPeakSize() const { return m_peakSize; }
+
+    void reset(int cellCount) {
+        m_lazy = {};
+        if (m_kind == OpenListKind::IndexedDaryHeap) m_indexed.reset(cellCount);
+        if (m_kind == OpenListKind::BucketQueue) m_buckets.reset(cellCount);
+        m_peakSize = 0;
+    }
+
+    bool empty() const {
+        switch (m_kind) {
+            case OpenListKind::IndexedDaryHeap: return m_indexed.empty();
+            case OpenListKind::BucketQueue: return m_buckets.empty();
+            default: return m_lazy.empty();
+        }
+    }
+
+    std::size_t size() const {
+        switch (m_kind) {
+            case OpenListKind::IndexedDaryHeap: return m_indexed.size();
+            case OpenListKind::BucketQueue: return m_buckets.size();
+            default: return m_lazy.size();
+        }
+    }
+
+    int topPriority() const {
+        switch (m_kind) {
+            case OpenListKind::IndexedDaryHeap: return getPriority(m_indexed.top().key);
+            case OpenListKind::BucketQueue: return m_buckets.topKey();
+            default: return getPriority(m_lazy.top());
+        }
+    }
+
+    CellId pop() {
+        CellId cell;
+        switch (m_kind) {
+            case OpenListKind::IndexedDaryHeap:
+                cell = m_indexed.top().cell;
+                m_indexed.pop();
+                break;
+            case OpenListKind::BucketQueue:
+                cell = m_buckets.pop();
+                break;
+            default:
+                cell = getCell(m_lazy.top());
+                m_lazy.pop();
+                break;
+        }
+        return cell;
+    }
+
+    // g breaks ties in the bucket queue; the heaps order ties by CellId.
+    void push(CellId cell, int priority, int g = 0) {
+        switch (m_kind) {
+            case OpenListKind::IndexedDaryHeap: m_indexed.push(cell, makePQElement(priority, cell)); break;
+            case OpenListKind::BucketQueue: m_buckets.push(cell, priority, g); break;
+            default: m_lazy.push(makePQElement(priority, cell)); break;
+        }
+        if (size() > m_peakSize) m_peakSize = size();
+    }
+
+private:
+    OpenListKind m_kind;
+    LazyPriorityQueue m_lazy;
+    IndexedDaryHeap<4> m_indexed;
+    BucketQueue m_buckets;
+    std::size_t m_peakSize = 0;
+};
\ No newline at end of file
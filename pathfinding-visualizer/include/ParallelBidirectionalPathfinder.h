@@ -0,0 +1,69 @@
+#pragma once
+#include "IPathfinder.h"
+#include "OpenList.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Bidirectional A* with the forward and backward searches on two threads.
+// Each side owns its open list and SearchState (the backward side keeps its
+// g/parent in the forward fields of m_stateBwd), so neither thread writes the
+// other's data. g values are also published in per-cell atomics, which the
+// other side reads to spot meetings; the best meeting cost and cell share one
+// 64-bit atomic updated by compare-and-swap.
+//
+// A side ends the search once the smallest f in its own open list reaches the
+// best meeting cost: with the consistent octile heuristic, no path through its
+// unexpanded cells can be cheaper, whatever the other side is doing.
+//
+// step() runs both sides for up to expansionsPerStep expansions each and joins
+// them before returning, so the visualizer always reads a quiescent state.
+// Pass a large budget to answer a query in a single call. With threads = 1 the
+// two sides take turns on the calling thread instead, which gives a baseline
+// for the same search.
+class ParallelBidirectionalPathfinder : public IPathfinder {
+public:
+    explicit ParallelBidirectionalPathfinder(int expansionsPerStep = 1, int threads = 2);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override;
+    void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_open[0].getPeakSize() + m_open[1].getPeakSize(); }
+    double getSuboptimalityBound() const override { return 1.0; }
+    bool isVisitedFwd(CellId id) const override { return m_state.isVisitedFwd(id); }
+    bool isVisitedBwd(CellId id) const override { return m_stateBwd.isVisitedFwd(id); }
+
+private:
+    static constexpr std::uint64_t kNoMeeting = ~0ULL;
+    // Expansions per turn when both sides share one thread.
+    static constexpr int kTurnLength = 64;
+
+    // Runs one side (0 = forward, 1 = backward) for at most budget pops.
+    void expand(int side, int budget);
+    void publish(int side, CellId cell, int g);
+    int readPublished(int side, CellId cell) const;
+    void offerMeeting(int cost, CellId cell);
+    int meetingCost() const;
+    int heuristic(const Point& pos, const Point& target) const;
+
+    std::string m_name;
+    int m_expansionsPerStep;
+    std::unique_ptr<ThreadPool> m_pool; // null when single-threaded
+    OpenList m_open[2];
+    SearchState m_stateBwd;
+
+    // (generation << 32 | g) per cell and side; older generations read as unreached.
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_published[2];
+    int m_publishedSize = 0;
+    std::uint32_t m_generation = 0;
+
+    // (cost << 32 | cell), so the smaller word is the cheaper meeting.
+    std::atomic<std::uint64_t> m_meeting{kNoMeeting};
+    std::atomic<bool> m_finished{false};
+    Point m_lastExpanded[2];
+
+    Point m_start;
+    Point m_end;
+};
\ No newline at end of file
@@ -1,21 +1,30 @@
 #pragma once
+#include <cstdint>
 #include <utility>
 #include <limits>
 
 using Point = std::pair<int, int>;
 
+// Chỉ số tuyến tính 32-bit của một ô (row * stride + col trong bộ đệm có viền).
+// Dùng trong các vòng lặp tìm kiếm thay cho Point; đổi qua lại bằng
+// Grid::index() và Grid::toPoint().
+struct CellId {
+    std::uint32_t value;
+
+    constexpr CellId() : value(0xFFFFFFFFu) {}
+    constexpr explicit CellId(std::uint32_t v) : value(v) {}
+
+    static constexpr CellId invalid() { return CellId(); }
+    constexpr bool isValid() const { return value != 0xFFFFFFFFu; }
+
+    CellId operator+(int offset) const { return CellId(value + static_cast<std::uint32_t>(offset)); }
+    bool operator==(CellId other) const { return value == other.value; }
+    bool operator!=(CellId other) const { return value != other.value; }
+    bool operator<(CellId other) const { return value < other.value; }
+};
+
+// Dữ liệu địa hình, dùng chung cho mọi thuật toán
 struct Node {
     bool is_wall = false;
     int weight = 1;
-
-    // Dữ liệu cho các thuật toán
-    int g_score = std::numeric_limits<int>::max();
-    Point parent = {-1, -1};
-    
-    // Dữ liệu cho tìm kiếm 2 chiều
-    int g_score_bwd = std::numeric_limits<int>::max();
-    Point parent_bwd = {-1, -1};
-
-    bool visited_fwd = false;
-    bool visited_bwd = false;
 };
\ No newline at end of file
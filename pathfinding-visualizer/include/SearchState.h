@@ -0,0 +1,69 @@
+#pragma once
+#include "Point.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Grid;
+
+// Per-search data kept as parallel arrays indexed by CellId. Each
+// pathfinder owns one of these, while the terrain in Grid is shared.
+//
+// A cell's fields are only meaningful while its stamp equals the current
+// generation; anything older reads as unvisited. reset() therefore just bumps
+// the generation and only sweeps the arrays when the counter wraps.
+class SearchState {
+public:
+    static constexpr int kInfinity = std::numeric_limits<int>::max();
+
+    void resize(int cellCount);
+    void reset();
+    int size() const { return static_cast<int>(g_score.size()); }
+    // Bytes held by the per-cell arrays.
+    std::size_t getMemoryBytes() const;
+
+    bool isTouched(CellId id) const { return stamp[id.value] == generation; }
+
+    int getGScore(CellId id) const { return isTouched(id) ? g_score[id.value] : kInfinity; }
+    void setGScore(CellId id, int g) { touch(id); g_score[id.value] = g; }
+    CellId getParent(CellId id) const { return isTouched(id) ? parent[id.value] : CellId::invalid(); }
+    void setParent(CellId id, CellId p) { touch(id); parent[id.value] = p; }
+
+    int getGScoreBwd(CellId id) const { return isTouched(id) ? g_score_bwd[id.value] : kInfinity; }
+    void setGScoreBwd(CellId id, int g) { touch(id); g_score_bwd[id.value] = g; }
+    CellId getParentBwd(CellId id) const { return isTouched(id) ? parent_bwd[id.value] : CellId::invalid(); }
+    void setParentBwd(CellId id, CellId p) { touch(id); parent_bwd[id.value] = p; }
+
+    bool isVisitedFwd(CellId id) const { return isTouched(id) && (flags[id.value] & kVisitedFwd) != 0; }
+    bool isVisitedBwd(CellId id) const { return isTouched(id) && (flags[id.value] & kVisitedBwd) != 0; }
+    void setVisitedFwd(CellId id) { touch(id); flags[id.value] |= kVisitedFwd; }
+    void setVisitedBwd(CellId id) { touch(id); flags[id.value] |= kVisitedBwd; }
+
+    // Follows parents back from `last`: the goal, or for a bidirectional
+    // search the meeting point, from which parent_bwd leads on to the goal.
+    std::vector<Point> reconstructPath(const Grid& grid, CellId last, bool isBidirectional = false) const;
+
+private:
+    static constexpr std::uint8_t kVisitedFwd = 1;
+    static constexpr std::uint8_t kVisitedBwd = 2;
+
+    // First write to a cell in this generation clears whatever it held before.
+    void touch(CellId id) {
+        if (stamp[id.value] == generation) return;
+        stamp[id.value] = generation;
+        g_score[id.value] = kInfinity;
+        parent[id.value] = CellId::invalid();
+        g_score_bwd[id.value] = kInfinity;
+        parent_bwd[id.value] = CellId::invalid();
+        flags[id.value] = 0;
+    }
+
+    std::vector<std::uint32_t> stamp;
+    std::uint32_t generation = 1;
+
+    std::vector<int> g_score;
+    std::vector<CellId> parent;
+    std::vector<int> g_score_bwd;
+    std::vector<CellId> parent_bwd;
+    std::vector<std::uint8_t> flags;
+};
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+#include "IPathfinder.h"
+#include "OpenList.h"
+#include <vector>
+
+// Any-angle search: A* on the grid, except that a cell may take its parent's
+// parent as its own parent when the two see each other, so paths run straight
+// between the corners they bend around instead of zig-zagging.
+//  - Theta* checks line of sight for every neighbour it relaxes.
+//  - Lazy Theta* assumes it, and only checks once per expansion, when the
+//    cell leaves the open list; if the line is blocked, the cell falls back
+//    to its best expanded neighbour.
+//
+// Costs are Euclidean, in thousandths of a cell, with a Euclidean heuristic.
+// getWaypoints() holds the corners of the path; getPath() holds every cell
+// the straight lines between them cross (see Grid::appendLine), which is a
+// valid 8-connected path.
+class ThetaStarPathfinder : public IPathfinder {
+public:
+    static constexpr int kUnit = 1000; // cost of one cell
+
+    explicit ThetaStarPathfinder(bool lazy = false);
+    using IPathfinder::init;
+    void init(const Grid& grid, const Point& start, const Point& end) override;
+    AlgoState step() override;
+    std::string getName() const override { return m_lazy ? "Lazy Theta*" : "Theta*"; }
+    void onWallChanged(const Point& pos) override;
+    std::size_t getPeakOpenSize() const override { return m_peakOpen; }
+
+    const std::vector<Point>& getWaypoints() const { return m_waypoints; }
+    // Euclidean length of the path, in cells.
+    double getPathLength() const { return m_pathLength; }
+    long long getLineOfSightChecks() const { return m_losChecks; }
+
+private:
+    int distance(CellId a, CellId b) const;
+    bool lineOfSight(CellId a, CellId b);
+    // Lazy Theta*: makes sure current's parent is visible, or else re-parents
+    // it to the cheapest expanded neighbour.
+    void setVertex(CellId current);
+    // Keys ordered by f, ties going to the larger g.
+    std::uint64_t calculateKey(CellId cell, int g) const;
+
+    bool m_lazy;
+    IndexedDaryHeap<4> m_open;
+    std::size_t m_peakOpen = 0;
+    std::vector<Point> m_waypoints;
+    double m_pathLength = 0.0;
+    long long m_losChecks = 0;
+    bool m_done = false;
+
+    Point m_start;
+    Point m_end;
+    CellId m_endCell;
+};
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads for data-parallel work. runOnAll() hands
+// the same task to every worker, passing its index, and returns when all of
+// them have finished; the task splits the work itself (e.g. by pulling
+// indices from an atomic counter).
+class ThreadPool {
+public:
+    // threads <= 0 uses one worker per hardware thread.
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return static_cast<int>(m_threads.size()); }
+    void runOnAll(const std::function<void(int worker)>& task);
+
+private:
+    void workerLoop(int index);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(int)>* m_task = nullptr;
+    std::uint64_t m_round = 0;
+    int m_running = 0;
+    bool m_stop = false;
+};
\ No newline at end of file
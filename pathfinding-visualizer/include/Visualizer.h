@@ -1,5 +1,6 @@
 #pragma once
 #include "IPathfinder.h"
+#include "CooperativePlanner.h"
 #include <vector>
 #include <memory>
 
@@ -7,6 +8,8 @@ class Visualizer {
 public:
     Visualizer();
     void drawUI(const std::vector<std::unique_ptr<IPathfinder>>& pathfinders, const std::vector<AlgoState>& states, const Point* cursor, int speed);
+    // Multi-agent view: agent i is the letter 'A' + i, its goal the lower-case letter.
+    void drawAgents(const Grid& grid, const CooperativePlanner& planner, int lastConflicts);
 
 private:
     void drawGrid(int y_offset, int x_offset, const IPathfinder& pf, AlgoState state, const Point* cursor);
@@ -0,0 +1,137 @@
+#include "ARAStarPathfinder.h"
+#include "Bits.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+ARAStarPathfinder::ARAStarPathfinder(double initialWeight, double weightStep)
+    : m_initialWeight(std::max(100, static_cast<int>(std::lround(initialWeight * 100)))),
+      m_weightStep(std::max(1, static_cast<int>(std::lround(weightStep * 100)))) {
+    std::ostringstream name;
+    name << "ARA* (w " << m_initialWeight / 100.0 << " -> 1)";
+    m_name = name.str();
+}
+
+std::string ARAStarPathfinder::getName() const { return m_name; }
+
+void ARAStarPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    const int cells = m_grid->getCellCount();
+    m_state.resize(cells);
+    m_state.reset();
+    m_start = start;
+    m_end = end;
+    m_endCell = m_grid->index(end);
+    m_open.reset(cells);
+    m_peakOpen = 0;
+    m_expansions = 0;
+    m_path.clear();
+    m_closedRound.assign(static_cast<size_t>(cells), 0);
+    m_inconsRound.assign(static_cast<size_t>(cells), 0);
+    m_incons.clear();
+    m_round = 1;
+    m_weight = m_initialWeight;
+    m_bound = std::numeric_limits<double>::infinity();
+    m_done = false;
+
+    CellId start_cell = m_grid->index(start);
+    if (!m_grid->isReachable(start_cell, m_endCell)) return;
+    m_state.setGScore(start_cell, 0);
+    m_open.push(start_cell, calculateKey(start_cell));
+    m_peakOpen = 1;
+}
+
+void ARAStarPathfinder::onWallChanged(const Point& pos) {
+    init(*m_grid, m_start, m_end);
+}
+
+AlgoState ARAStarPathfinder::step() {
+    if (m_done) return m_path.empty() ? AlgoState::PathNotFound : AlgoState::PathFound;
+
+    // The round ends once nothing queued can beat the goal's own key.
+    int goal_g = m_state.getGScore(m_endCell);
+    std::uint64_t goal_key = goal_g == SearchState::kInfinity ? ~0ULL : static_cast<std::uint64_t>(goal_g) * 100 << 32;
+    if (m_open.empty() || m_open.top().key >= goal_key) return finishRound();
+
+    CellId current = m_open.top().cell;
+    m_open.pop();
+    m_closedRound[current.value] = m_round;
+    m_state.setVisitedFwd(current);
+    m_currentlyProcessing = m_grid->toPoint(current);
+    ++m_expansions;
+    int current_g = m_state.getGScore(current);
+
+    for (unsigned open_dirs = m_grid->getNeighborMask(current); open_dirs; open_dirs &= open_dirs - 1) {
+        int i = bits::countTrailingZeros(open_dirs);
+        CellId neighbor = current + m_grid->getNeighborOffset(i);
+        int tentative_g_score = current_g + (i < 4 ? 10 : 14);
+        if (tentative_g_score >= m_state.getGScore(neighbor)) continue;
+        m_state.setParent(neighbor, current);
+        m_state.setGScore(neighbor, tentative_g_score);
+        if (m_closedRound[neighbor.value] != m_round) {
+            m_open.push(neighbor, calculateKey(neighbor));
+        } else if (m_inconsRound[neighbor.value] != m_round) {
+            // Already expanded this round: it waits for the next one.
+            m_inconsRound[neighbor.value] = m_round;
+            m_incons.push_back(neighbor);
+        }
+    }
+    m_peakOpen = std::max(m_peakOpen, m_open.size() + m_incons.size());
+    return AlgoState::Running;
+}
+
+AlgoState ARAStarPathfinder::finishRound() {
+    int goal_g = m_state.getGScore(m_endCell);
+    if (goal_g == SearchState::kInfinity) {
+        m_done = true;
+        return AlgoState::PathNotFound;
+    }
+    m_path = m_state.reconstructPath(*m_grid, m_endCell);
+
+    // Every cheaper path would have to pass a queued or inconsistent cell, so
+    // the smallest unweighted f among them bounds the optimum from below.
+    std::vector<CellId> pending;
+    pending.reserve(m_open.size() + m_incons.size());
+    while (!m_open.empty()) {
+        pending.push_back(m_open.top().cell);
+        m_open.pop();
+    }
+    pending.insert(pending.end(), m_incons.begin(), m_incons.end());
+    m_incons.clear();
+    int lower = SearchState::kInfinity;
+    for (CellId cell : pending) lower = std::min(lower, m_state.getGScore(cell) + heuristic(cell));
+    double bound = lower >= goal_g ? 1.0 : static_cast<double>(goal_g) / lower;
+    m_bound = std::min(m_bound, std::min(m_weight / 100.0, bound));
+
+    if (m_weight == 100 || m_bound <= 1.0) {
+        m_bound = 1.0;
+        m_done = true;
+        return AlgoState::PathFound;
+    }
+
+    // Next round: smaller weight, OPEN and INCONS re-keyed, CLOSED emptied.
+    m_weight = std::max(100, m_weight - m_weightStep);
+    ++m_round;
+    for (CellId cell : pending) m_open.push(cell, calculateKey(cell));
+    return AlgoState::Running;
+}
+
+int ARAStarPathfinder::heuristic(CellId cell) const {
+    // Octile distance: consistent for the 10/14 model, so w bounds each round
+    Point p = m_grid->toPoint(cell);
+    int dr = std::abs(p.first - m_end.first);
+    int dc = std::abs(p.second - m_end.second);
+    return 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+}
+
+std::uint64_t ARAStarPathfinder::calculateKey(CellId cell) const {
+    std::uint32_t g = static_cast<std::uint32_t>(m_state.getGScore(cell));
+    std::uint64_t f = static_cast<std::uint64_t>(g) * 100 + static_cast<std::uint64_t>(m_weight) * heuristic(cell);
+    return f << 32 | (0xFFFFFFFFu - g);
+}
+
+std::size_t ARAStarPathfinder::getPeakMemoryBytes() const {
+    return m_state.getMemoryBytes() + (m_closedRound.capacity() + m_inconsRound.capacity()) * sizeof(std::uint32_t) +
+           m_incons.capacity() * sizeof(CellId) + m_open.getMemoryBytes();
+}
\ No newline at end of file
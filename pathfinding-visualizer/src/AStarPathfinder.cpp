@@ -1,73 +1,90 @@
 #include "AStarPathfinder.h"
+#include "Bits.h"
 #include <cmath>
 
-AStarPathfinder::AStarPathfinder(bool isDijkstra) : m_isDijkstra(isDijkstra) {
+AStarPathfinder::AStarPathfinder(bool isDijkstra, OpenListKind openList, std::shared_ptr<const LandmarkHeuristic> landmarks)
+    : m_isDijkstra(isDijkstra), m_open(openList), m_landmarks(std::move(landmarks)) {
     m_name = isDijkstra ? "Dijkstra" : "A* Search";
+    if (!isDijkstra && m_landmarks) m_name += " + ALT";
+    m_name += getOpenListLabel(openList);
 }
 
 std::string AStarPathfinder::getName() const { return m_name; }
 
-void AStarPathfinder::init(Grid& grid) {
+void AStarPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
     m_grid = &grid;
-    m_grid->reset();
-    m_start = m_grid->getStart();
-    m_end = m_grid->getEnd();
-    m_pq = {};
+    m_state.resize(m_grid->getCellCount());
+    m_state.reset();
+    m_start = start;
+    m_end = end;
+    m_endCell = m_grid->index(m_end);
+    m_open.reset(m_grid->getCellCount());
     m_path.clear();
 
-    m_grid->getNode(m_start.first, m_start.second).g_score = 0;
-    int h_start = m_isDijkstra ? 0 : heuristic(m_start, m_end);
-    m_pq.push({h_start, m_start});
+    CellId start_cell = m_grid->index(m_start);
+    // Different components: leave the open list empty so the first step
+    // reports PathNotFound instead of flooding the start's whole region.
+    if (!m_grid->isReachable(start_cell, m_endCell)) return;
+    m_state.setGScore(start_cell, 0);
+    int h_start = m_isDijkstra ? 0 : heuristic(start_cell, m_start);
+    m_open.push(start_cell, h_start);
+}
+
+double AStarPathfinder::getSuboptimalityBound() const {
+    return m_isDijkstra || m_landmarks ? 1.0 : IPathfinder::getSuboptimalityBound();
 }
 
 void AStarPathfinder::onWallChanged(const Point& pos) {
-    init(*m_grid);
+    init(*m_grid, m_start, m_end);
 }
 
 AlgoState AStarPathfinder::step() {
-    if (m_pq.empty()) {
-        m_grid->setCurrentlyProcessing({-1, -1});
+    if (m_open.empty()) {
+        m_currentlyProcessing = {-1, -1};
         return AlgoState::PathNotFound;
     }
 
-    Point current_pos = m_pq.top().second;
-    m_pq.pop();
+    CellId current = m_open.pop();
 
-    Node& current_node = m_grid->getNode(current_pos.first, current_pos.second);
-    if (current_node.visited_fwd) {
+    if (m_state.isVisitedFwd(current)) {
         return AlgoState::Running;
     }
-    current_node.visited_fwd = true;
-    m_grid->setCurrentlyProcessing(current_pos);
+    m_state.setVisitedFwd(current);
+    Point current_pos = m_grid->toPoint(current);
+    m_currentlyProcessing = current_pos;
 
-    if (current_pos == m_end) {
-        m_path = m_grid->reconstructPath();
-        m_grid->setCurrentlyProcessing({-1, -1});
+    if (current == m_endCell) {
+        m_path = m_state.reconstructPath(*m_grid, m_endCell);
+        m_currentlyProcessing = {-1, -1};
         return AlgoState::PathFound;
     }
 
     const int dr[] = {-1, 1, 0, 0, -1, -1, 1, 1};
     const int dc[] = {0, 0, -1, 1, -1, 1, -1, 1};
+    int current_g = m_state.getGScore(current);
+
+    // Walk the set bits of the successor mask instead of testing all 8 directions
+    for (unsigned open_dirs = m_grid->getNeighborMask(current); open_dirs; open_dirs &= open_dirs - 1) {
+        int i = bits::countTrailingZeros(open_dirs);
+        CellId neighbor = current + m_grid->getNeighborOffset(i);
 
-    for (int i = 0; i < 8; ++i) { // 8 directions for diagonal movement
-        Point neighbor_pos = {current_pos.first + dr[i], current_pos.second + dc[i]};
-        if (m_grid->isValid(neighbor_pos.first, neighbor_pos.second) && !m_grid->getNode(neighbor_pos.first, neighbor_pos.second).is_wall) {
-            int cost = (i < 4) ? 10 : 14; // 1 for straight, ~1.4 for diagonal (multiplied by 10)
-            Node& neighbor_node = m_grid->getNode(neighbor_pos.first, neighbor_pos.second);
-            int tentative_g_score = current_node.g_score + cost;
+        int cost = (i < 4) ? 10 : 14; // 1 for straight, ~1.4 for diagonal (multiplied by 10)
+        int tentative_g_score = current_g + cost;
 
-            if (tentative_g_score < neighbor_node.g_score) {
-                neighbor_node.parent = current_pos;
-                neighbor_node.g_score = tentative_g_score;
-                int h_score = m_isDijkstra ? 0 : heuristic(neighbor_pos, m_end);
-                m_pq.push({tentative_g_score + h_score, neighbor_pos});
-            }
+        if (tentative_g_score < m_state.getGScore(neighbor)) {
+            m_state.setParent(neighbor, current);
+            m_state.setGScore(neighbor, tentative_g_score);
+            Point neighbor_pos = {current_pos.first + dr[i], current_pos.second + dc[i]};
+            int h_score = m_isDijkstra ? 0 : heuristic(neighbor, neighbor_pos);
+            // Dijkstra's buckets each hold a single g, so it has no ties to break.
+            m_open.push(neighbor, tentative_g_score + h_score, m_isDijkstra ? 0 : tentative_g_score);
         }
     }
     return AlgoState::Running;
 }
 
-int AStarPathfinder::heuristic(const Point& a, const Point& b) {
+int AStarPathfinder::heuristic(CellId cell, const Point& pos) const {
+    if (m_landmarks) return m_landmarks->estimate(cell, m_endCell);
     // Manhattan distance
-    return (std::abs(a.first - b.first) + std::abs(a.second - b.second)) * 10;
+    return (std::abs(pos.first - m_end.first) + std::abs(pos.second - m_end.second)) * 10;
 }
\ No newline at end of file
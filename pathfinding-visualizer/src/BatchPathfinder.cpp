@@ -0,0 +1,51 @@
+#include "BatchPathfinder.h"
+#include "AStarPathfinder.h"
+#include "BidirectionalPathfinder.h"
+#include "JumpPointSearchPathfinder.h"
+#include <algorithm>
+#include <atomic>
+
+std::unique_ptr<IPathfinder> createPathfinder(PathAlgorithm algorithm) {
+    switch (algorithm) {
+        case PathAlgorithm::Dijkstra: return std::make_unique<AStarPathfinder>(true);
+        case PathAlgorithm::Bidirectional: return std::make_unique<BidirectionalPathfinder>();
+        case PathAlgorithm::JumpPointSearch: return std::make_unique<JumpPointSearchPathfinder>();
+        case PathAlgorithm::JumpPointSearchPlus: return std::make_unique<JumpPointSearchPathfinder>(true);
+        default: return std::make_unique<AStarPathfinder>(false);
+    }
+}
+
+BatchPathfinder::BatchPathfinder(const Grid& grid, int threads) : m_grid(grid), m_pool(threads) {}
+
+std::vector<PathResult> BatchPathfinder::run(const std::vector<PathQuery>& queries, PathAlgorithm algorithm) {
+    if (m_workers.empty() || algorithm != m_algorithm) {
+        m_workers.clear();
+        for (int i = 0; i < m_pool.size(); ++i) m_workers.push_back(createPathfinder(algorithm));
+        m_algorithm = algorithm;
+    }
+
+    std::vector<PathResult> results(queries.size());
+    // Small chunks keep the workers balanced when query lengths vary a lot.
+    const std::size_t kChunk = 8;
+    std::atomic<std::size_t> next(0);
+    m_pool.runOnAll([&](int worker) {
+        IPathfinder& pf = *m_workers[worker];
+        while (true) {
+            std::size_t begin = next.fetch_add(kChunk);
+            if (begin >= queries.size()) return;
+            std::size_t end = std::min(begin + kChunk, queries.size());
+            for (std::size_t i = begin; i < end; ++i) {
+                const PathQuery& q = queries[i];
+                PathResult& result = results[i];
+                if (!m_grid.isValid(q.start.first, q.start.second) || !m_grid.isValid(q.goal.first, q.goal.second)) continue;
+                pf.init(m_grid, q.start, q.goal);
+                while ((result.state = pf.step()) == AlgoState::Running) {}
+                if (result.state == AlgoState::PathFound) {
+                    result.path = pf.getPath();
+                    result.cost = pathCost(result.path);
+                }
+            }
+        }
+    });
+    return results;
+}
\ No newline at end of file
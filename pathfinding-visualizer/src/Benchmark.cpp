@@ -0,0 +1,878 @@
+#include "Benchmark.h"
+#include "AStarPathfinder.h"
+#include "BidirectionalPathfinder.h"
+#include "JumpPointSearchPathfinder.h"
+#include "LPAStarPathfinder.h"
+#include "HierarchicalPathfinder.h"
+#include "LandmarkHeuristic.h"
+#include "BatchPathfinder.h"
+#include "ParallelBidirectionalPathfinder.h"
+#include "DeltaStepping.h"
+#include "BitboardBfs.h"
+#include "FlowField.h"
+#include "CooperativePlanner.h"
+#include "ARAStarPathfinder.h"
+#include "IDAStarPathfinder.h"
+#include "FrontierSearchPathfinder.h"
+#include "ThetaStarPathfinder.h"
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+
+namespace bench {
+    Grid makeScatterMap(int rows, int cols, int wallPercent, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::string> layout(rows, std::string(cols, ' '));
+        for (auto& line : layout) {
+            for (auto& ch : line) {
+                if (static_cast<int>(rng() % 100) < wallPercent) ch = '#';
+            }
+        }
+        layout[0][0] = 'S';
+        layout[rows - 1][cols - 1] = 'E';
+        Grid grid(rows, cols);
+        grid.createMazeFromLayout(layout);
+        return grid;
+    }
+
+    RunResult runToCompletion(IPathfinder& pf, const Grid& grid) {
+        RunResult result;
+        pf.init(grid);
+        auto begin = std::chrono::steady_clock::now();
+        while ((result.state = pf.step()) == AlgoState::Running) ++result.steps;
+        auto end = std::chrono::steady_clock::now();
+        result.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+        result.pathCost = pathCost(pf.getPath());
+        return result;
+    }
+
+    static void printHeader(const std::string& title) {
+        std::cout << "\n== " << title << " ==\n";
+        std::cout << std::left << std::setw(34) << "Algorithm" << std::right
+                  << std::setw(12) << "Steps" << std::setw(12) << "Peak open"
+                  << std::setw(10) << "Cost" << std::setw(12) << "ms" << std::setw(14) << "Steps/s" << '\n';
+    }
+
+    static void printRow(const IPathfinder& pf, const RunResult& r) {
+        double perSecond = r.milliseconds > 0 ? r.steps / (r.milliseconds / 1000.0) : 0.0;
+        std::cout << std::left << std::setw(34) << pf.getName() << std::right
+                  << std::setw(12) << r.steps << std::setw(12) << pf.getPeakOpenSize()
+                  << std::setw(10) << (r.state == AlgoState::PathFound ? r.pathCost : -1)
+                  << std::setw(12) << std::fixed << std::setprecision(2) << r.milliseconds
+                  << std::setw(14) << std::setprecision(0) << perSecond << '\n';
+    }
+
+    struct MapCase {
+        std::string name;
+        Grid grid;
+    };
+
+    static std::vector<MapCase> standardMaps() {
+        std::vector<MapCase> maps;
+        maps.push_back({"open 1000x1000, 20% walls", makeScatterMap(1000, 1000, 20, 1)});
+        maps.push_back({"open 1000x1000, 35% walls", makeScatterMap(1000, 1000, 35, 2)});
+        Grid maze(151, 151);
+        maze.generateMaze();
+        maps.push_back({"maze 151x151", maze});
+        return maps;
+    }
+
+    // Each query runs five times on the same pathfinder and the median time
+    // is kept, which is what repeated queries see: the first run also pays
+    // for growing the queue's buffers.
+    void runOpenListBenchmark() {
+        for (const auto& map : standardMaps()) {
+            printHeader("Open list: " + map.name);
+            std::vector<std::unique_ptr<IPathfinder>> pathfinders;
+            for (OpenListKind kind : {OpenListKind::LazyBinaryHeap, OpenListKind::IndexedDaryHeap, OpenListKind::BucketQueue}) {
+                pathfinders.push_back(std::make_unique<AStarPathfinder>(false, kind));
+                pathfinders.push_back(std::make_unique<AStarPathfinder>(true, kind));
+                pathfinders.push_back(std::make_unique<BidirectionalPathfinder>(kind));
+            }
+            for (auto& pf : pathfinders) {
+                std::vector<RunResult> runs;
+                for (int i = 0; i < 5; ++i) runs.push_back(runToCompletion(*pf, map.grid));
+                std::sort(runs.begin(), runs.end(), [](const RunResult& a, const RunResult& b) { return a.milliseconds < b.milliseconds; });
+                printRow(*pf, runs[runs.size() / 2]);
+            }
+        }
+    }
+
+    void runJumpPointBenchmark() {
+        for (const auto& map : standardMaps()) {
+            printHeader("Jump point search: " + map.name);
+            AStarPathfinder dijkstra(true);
+            AStarPathfinder astar(false);
+            JumpPointSearchPathfinder jps;
+            JumpPointSearchPathfinder jpsPlus(true);
+            RunResult optimal = runToCompletion(dijkstra, map.grid);
+            printRow(dijkstra, optimal);
+            printRow(astar, runToCompletion(astar, map.grid));
+            RunResult r = runToCompletion(jps, map.grid);
+            printRow(jps, r);
+            std::cout << "JPS cost " << (r.pathCost == optimal.pathCost ? "matches" : "DIFFERS FROM") << " Dijkstra\n";
+
+            Grid grid = map.grid;
+            auto begin = std::chrono::steady_clock::now();
+            grid.buildJumpTable();
+            double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            r = runToCompletion(jpsPlus, grid);
+            printRow(jpsPlus, r);
+            std::cout << "JPS+ cost " << (r.pathCost == optimal.pathCost ? "matches" : "DIFFERS FROM") << " Dijkstra\n";
+
+            // Each toggle is applied twice so the map ends up unchanged.
+            const int toggles = 200;
+            std::mt19937 rng(3);
+            begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < toggles; ++i) {
+                Point p = {static_cast<int>(rng() % grid.getRows()), static_cast<int>(rng() % grid.getCols())};
+                grid.toggleWall(p);
+                grid.toggleWall(p);
+            }
+            double toggleMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            std::cout << std::fixed << std::setprecision(2) << "Jump table: full build " << buildMs
+                      << " ms, repair per wall toggle " << std::setprecision(3) << toggleMs / (2 * toggles) << " ms\n";
+        }
+    }
+
+    // Edits the map one wall at a time and compares LPA*'s repair of its
+    // previous search with Dijkstra and A* planning again from scratch. Half
+    // of the edits block a cell on the current path, so a reroute is forced.
+    void runReplanningBenchmark() {
+        Grid grid = makeScatterMap(1000, 1000, 20, 1);
+        LPAStarPathfinder lpa;
+        AStarPathfinder dijkstra(true);
+        AStarPathfinder astar(false);
+        printHeader("Replanning: initial search, open 1000x1000, 20% walls");
+        printRow(lpa, runToCompletion(lpa, grid));
+
+        const int edits = 40;
+        std::mt19937 rng(5);
+        long long lpaSteps = 0, dijkstraSteps = 0, astarSteps = 0;
+        double lpaMs = 0.0, dijkstraMs = 0.0, astarMs = 0.0;
+        int mismatches = 0;
+        for (int i = 0; i < edits; ++i) {
+            Point p = {static_cast<int>(rng() % grid.getRows()), static_cast<int>(rng() % grid.getCols())};
+            const std::vector<Point>& path = lpa.getPath();
+            if (i % 2 == 0 && path.size() > 2) p = path[1 + rng() % (path.size() - 2)];
+            grid.toggleWall(p);
+
+            RunResult r;
+            auto begin = std::chrono::steady_clock::now();
+            lpa.onWallChanged(p);
+            while ((r.state = lpa.step()) == AlgoState::Running) ++r.steps;
+            lpaMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            lpaSteps += r.steps;
+
+            RunResult optimal = runToCompletion(dijkstra, grid);
+            dijkstraSteps += optimal.steps;
+            dijkstraMs += optimal.milliseconds;
+            RunResult rough = runToCompletion(astar, grid);
+            astarSteps += rough.steps;
+            astarMs += rough.milliseconds;
+            if (pathCost(lpa.getPath()) != optimal.pathCost || r.state != optimal.state) ++mismatches;
+        }
+        std::cout << "\nAverage per wall edit over " << edits << " edits:\n" << std::fixed << std::setprecision(3);
+        std::cout << std::left << std::setw(34) << lpa.getName() << std::right << std::setw(12) << lpaSteps / edits << " steps " << std::setw(10) << lpaMs / edits << " ms\n";
+        std::cout << std::left << std::setw(34) << "Dijkstra (restart)" << std::right << std::setw(12) << dijkstraSteps / edits << " steps " << std::setw(10) << dijkstraMs / edits << " ms\n";
+        std::cout << std::left << std::setw(34) << "A* Search (restart)" << std::right << std::setw(12) << astarSteps / edits << " steps " << std::setw(10) << astarMs / edits << " ms\n";
+        std::cout << "LPA* cost " << (mismatches == 0 ? "matches" : "DIFFERS FROM") << " Dijkstra after every edit\n";
+    }
+
+    // Corner-to-corner queries on growing maps, then random reachable pairs on
+    // the same maps. HPA* query time covers inserting start and goal, the
+    // abstract search and refinement; building the abstraction is reported
+    // separately, as is repairing it per edit. JPS supplies the optimal cost.
+    void runHierarchicalBenchmark() {
+        struct PairRow {
+            int size;
+            double meanMs;
+            double maxMs;
+            long long steps;
+            double ratio;
+            double jpsMs;
+        };
+        const int pairs = 20;
+        std::vector<PairRow> pairRows;
+
+        std::cout << "\n== Hierarchical search (HPA*, 16x16 clusters, 4x4 super-clusters), 20% walls ==\n";
+        std::cout << std::left << std::setw(12) << "Map" << std::right << std::setw(10) << "Nodes" << std::setw(8) << "Top"
+                  << std::setw(10) << "Build ms" << std::setw(11) << "Repair ms" << std::setw(10) << "Query ms"
+                  << std::setw(8) << "Steps" << std::setw(9) << "Cost" << std::setw(9) << "Optimal"
+                  << std::setw(8) << "Ratio" << std::setw(9) << "JPS ms" << std::setw(9) << "A* ms" << '\n';
+        for (int size : {250, 500, 1000, 2000}) {
+            Grid grid = makeScatterMap(size, size, 20, 7);
+            HierarchicalPathfinder hpa;
+            auto begin = std::chrono::steady_clock::now();
+            hpa.init(grid);
+            double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+            RunResult r;
+            begin = std::chrono::steady_clock::now();
+            hpa.init(grid);
+            while ((r.state = hpa.step()) == AlgoState::Running) ++r.steps;
+            double queryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            r.pathCost = pathCost(hpa.getPath());
+
+            JumpPointSearchPathfinder jps;
+            AStarPathfinder astar(false);
+            RunResult optimal = runToCompletion(jps, grid);
+            RunResult flat = runToCompletion(astar, grid);
+
+            // Corner queries cross the whole map; random pairs show what a
+            // typical query costs.
+            PairRow row = {size, 0.0, 0.0, 0, 0.0, 0.0};
+            long long hpaCost = 0, optimalCost = 0;
+            std::mt19937 pairRng(5);
+            for (int i = 0; i < pairs; ++i) {
+                Point s, t;
+                do {
+                    s = {static_cast<int>(pairRng() % size), static_cast<int>(pairRng() % size)};
+                    t = {static_cast<int>(pairRng() % size), static_cast<int>(pairRng() % size)};
+                } while (!grid.isReachable(grid.index(s), grid.index(t)));
+                begin = std::chrono::steady_clock::now();
+                hpa.init(grid, s, t);
+                while (hpa.step() == AlgoState::Running) ++row.steps;
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+                row.meanMs += ms / pairs;
+                row.maxMs = std::max(row.maxMs, ms);
+                hpaCost += pathCost(hpa.getPath());
+
+                begin = std::chrono::steady_clock::now();
+                jps.init(grid, s, t);
+                while (jps.step() == AlgoState::Running) {}
+                row.jpsMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / pairs;
+                optimalCost += pathCost(jps.getPath());
+            }
+            row.steps /= pairs;
+            row.ratio = optimalCost > 0 ? static_cast<double>(hpaCost) / optimalCost : 0.0;
+            pairRows.push_back(row);
+
+            // Each edit is undone right away so every query sees the same map.
+            const int edits = 50;
+            std::mt19937 rng(9);
+            begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < edits; ++i) {
+                Point p = {static_cast<int>(rng() % size), static_cast<int>(rng() % size)};
+                grid.toggleWall(p);
+                hpa.onWallChanged(p);
+                grid.toggleWall(p);
+                hpa.onWallChanged(p);
+            }
+            double repairMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / (2 * edits);
+
+            std::cout << std::left << std::setw(12) << (std::to_string(size) + "x" + std::to_string(size)) << std::right
+                      << std::setw(10) << hpa.getAbstractNodeCount() << std::setw(8) << hpa.getSuperNodeCount()
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(10) << buildMs << std::setprecision(3) << std::setw(11) << repairMs
+                      << std::setw(10) << queryMs << std::setw(8) << r.steps << std::setw(9) << r.pathCost
+                      << std::setw(9) << optimal.pathCost
+                      << std::setw(8) << (optimal.pathCost > 0 ? static_cast<double>(r.pathCost) / optimal.pathCost : 0.0)
+                      << std::setprecision(2) << std::setw(9) << optimal.milliseconds << std::setw(9) << flat.milliseconds << '\n';
+        }
+
+        std::cout << "\n" << pairs << " random reachable pairs per map (cost ratio over the summed costs):\n";
+        std::cout << std::left << std::setw(12) << "Map" << std::right << std::setw(10) << "Mean ms" << std::setw(10) << "Max ms"
+                  << std::setw(8) << "Steps" << std::setw(8) << "Ratio" << std::setw(9) << "JPS ms" << '\n';
+        for (const PairRow& row : pairRows) {
+            std::cout << std::left << std::setw(12) << (std::to_string(row.size) + "x" + std::to_string(row.size)) << std::right
+                      << std::fixed << std::setprecision(3) << std::setw(10) << row.meanMs << std::setw(10) << row.maxMs
+                      << std::setw(8) << row.steps << std::setw(8) << row.ratio
+                      << std::setprecision(2) << std::setw(9) << row.jpsMs << '\n';
+        }
+    }
+
+    // The goal is walled in, so every query is unreachable. With component
+    // labels the searches stop in init(); edits must keep the labels current.
+    void runUnreachableBenchmark() {
+        Grid grid = makeScatterMap(1000, 1000, 20, 1);
+        Point goal = grid.getEnd();
+        for (int k = 0; k <= 2; ++k) {
+            for (Point p : {Point{goal.first - 2, goal.second - k}, Point{goal.first - k, goal.second - 2}}) {
+                if (!grid.isWall(grid.index(p))) grid.toggleWall(p);
+            }
+        }
+
+        printHeader("Unreachable goal: open 1000x1000, 20% walls");
+        std::vector<std::unique_ptr<IPathfinder>> pathfinders;
+        pathfinders.push_back(std::make_unique<AStarPathfinder>(false));
+        pathfinders.push_back(std::make_unique<AStarPathfinder>(true));
+        pathfinders.push_back(std::make_unique<BidirectionalPathfinder>());
+        pathfinders.push_back(std::make_unique<JumpPointSearchPathfinder>());
+        for (auto& pf : pathfinders) printRow(*pf, runToCompletion(*pf, grid));
+
+        // Walls added on open cells may split a component; removing them
+        // again merges through union-find.
+        const int edits = 1000;
+        std::mt19937 rng(4);
+        std::vector<Point> added;
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < edits; ++i) {
+            Point p = {static_cast<int>(rng() % grid.getRows()), static_cast<int>(rng() % grid.getCols())};
+            if (grid.isWall(grid.index(p)) || p == grid.getStart() || p == grid.getEnd()) continue;
+            grid.toggleWall(p);
+            added.push_back(p);
+        }
+        double insertMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        begin = std::chrono::steady_clock::now();
+        for (const Point& p : added) grid.toggleWall(p);
+        double removeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << std::fixed << std::setprecision(4) << "Component upkeep per edit: wall insert "
+                  << insertMs / added.size() << " ms, wall removal " << removeMs / added.size() << " ms\n";
+    }
+
+    // Blind expansion is worst in winding corridors, so the maze comes first.
+    void runLandmarkBenchmark() {
+        std::vector<MapCase> maps = standardMaps();
+        std::rotate(maps.begin(), maps.end() - 1, maps.end());
+        for (const auto& map : maps) {
+            auto landmarks = std::make_shared<LandmarkHeuristic>(8);
+            auto begin = std::chrono::steady_clock::now();
+            landmarks->build(map.grid);
+            double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+            printHeader("Landmarks (ALT, 8 landmarks): " + map.name);
+            AStarPathfinder dijkstra(true);
+            RunResult optimal = runToCompletion(dijkstra, map.grid);
+            printRow(dijkstra, optimal);
+            std::vector<std::unique_ptr<IPathfinder>> pathfinders;
+            pathfinders.push_back(std::make_unique<AStarPathfinder>(false));
+            pathfinders.push_back(std::make_unique<AStarPathfinder>(false, OpenListKind::LazyBinaryHeap, landmarks));
+            pathfinders.push_back(std::make_unique<BidirectionalPathfinder>());
+            pathfinders.push_back(std::make_unique<BidirectionalPathfinder>(OpenListKind::LazyBinaryHeap, landmarks));
+            for (auto& pf : pathfinders) printRow(*pf, runToCompletion(*pf, map.grid));
+            std::cout << std::fixed << std::setprecision(2) << "Landmark tables built in " << buildMs << " ms\n";
+        }
+    }
+
+    // Random queries between open cells of the start's component, run with
+    // growing worker counts. Speedup is relative to one worker.
+    void runBatchBenchmark() {
+        Grid grid = makeScatterMap(1000, 1000, 20, 1);
+        grid.buildJumpTable();
+        std::mt19937 rng(6);
+        CellId home = grid.index(grid.getStart());
+        auto randomOpenCell = [&]() {
+            while (true) {
+                Point p = {static_cast<int>(rng() % grid.getRows()), static_cast<int>(rng() % grid.getCols())};
+                if (grid.isReachable(grid.index(p), home)) return p;
+            }
+        };
+        std::vector<PathQuery> queries(500);
+        for (PathQuery& q : queries) q = {randomOpenCell(), randomOpenCell()};
+
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        std::vector<int> threadCounts = {1, 2, 4};
+        if (hardware > 4) threadCounts.push_back(hardware);
+
+        std::cout << "\n== Batch queries: " << queries.size() << " random pairs, open 1000x1000, 20% walls ("
+                  << hardware << " hardware threads) ==\n";
+        std::cout << std::left << std::setw(34) << "Algorithm" << std::right << std::setw(10) << "Threads"
+                  << std::setw(12) << "ms" << std::setw(14) << "Queries/s" << std::setw(10) << "Speedup" << '\n';
+        for (PathAlgorithm algorithm : {PathAlgorithm::JumpPointSearchPlus, PathAlgorithm::AStar}) {
+            double baseMs = 0.0;
+            std::vector<PathResult> reference;
+            for (int threads : threadCounts) {
+                BatchPathfinder batch(grid, threads);
+                auto begin = std::chrono::steady_clock::now();
+                std::vector<PathResult> results = batch.run(queries, algorithm);
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+                if (threads == 1) {
+                    baseMs = ms;
+                    reference = results;
+                }
+                bool same = true;
+                for (size_t i = 0; i < results.size(); ++i) same = same && results[i].cost == reference[i].cost;
+
+                std::cout << std::left << std::setw(34) << createPathfinder(algorithm)->getName() << std::right
+                          << std::setw(10) << threads << std::fixed << std::setprecision(2) << std::setw(12) << ms
+                          << std::setprecision(0) << std::setw(14) << queries.size() / (ms / 1000.0)
+                          << std::setprecision(2) << std::setw(10) << baseMs / ms << (same ? "" : "  RESULTS DIFFER") << '\n';
+            }
+        }
+    }
+
+    // One query per map. The octile searches run it in a single step, so
+    // their step count is zero and only the time is comparable.
+    void runParallelBidirectionalBenchmark() {
+        for (const auto& map : standardMaps()) {
+            printHeader("Two-thread bidirectional A*: " + map.name + " ("
+                        + std::to_string(std::thread::hardware_concurrency()) + " hardware threads)");
+            AStarPathfinder dijkstra(true);
+            BidirectionalPathfinder sequential;
+            ParallelBidirectionalPathfinder oneThread(1 << 30, 1);
+            ParallelBidirectionalPathfinder twoThreads(1 << 30);
+            printRow(dijkstra, runToCompletion(dijkstra, map.grid));
+            printRow(sequential, runToCompletion(sequential, map.grid));
+            RunResult base = runToCompletion(oneThread, map.grid);
+            printRow(oneThread, base);
+            RunResult r = runToCompletion(twoThreads, map.grid);
+            printRow(twoThreads, r);
+            std::cout << std::fixed << std::setprecision(2) << "Speedup over one thread: " << base.milliseconds / r.milliseconds << "x\n";
+        }
+    }
+
+    // Distances from the start to every cell of a multi-million-cell map.
+    // Speedup is relative to sequential Dijkstra; thread counts above the
+    // hardware's only add scheduling overhead.
+    void runDeltaSteppingBenchmark() {
+        Grid grid = makeScatterMap(2000, 2000, 20, 7);
+        CellId source = grid.index(grid.getStart());
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<int> reference = computeDistances(grid, source);
+        double baseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        std::cout << "\n== Whole-map distances: open 2000x2000, 20% walls ("
+                  << std::thread::hardware_concurrency() << " hardware threads) ==\n";
+        std::cout << std::left << std::setw(34) << "Algorithm" << std::right << std::setw(10) << "Threads"
+                  << std::setw(12) << "Rounds" << std::setw(12) << "ms" << std::setw(10) << "Speedup" << '\n';
+        std::cout << std::left << std::setw(34) << "Dijkstra (sequential)" << std::right << std::setw(10) << 1
+                  << std::setw(12) << "-" << std::fixed << std::setprecision(2) << std::setw(12) << baseMs
+                  << std::setw(10) << 1.0 << '\n';
+        for (int threads : {1, 2, 4, 8, 16}) {
+            DeltaStepping engine(threads);
+            begin = std::chrono::steady_clock::now();
+            std::vector<int> distances = engine.run(grid, source);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            std::cout << std::left << std::setw(34) << "Delta-stepping (delta " + std::to_string(engine.getDelta()) + ")"
+                      << std::right << std::setw(10) << threads << std::setw(12) << engine.getRoundCount()
+                      << std::setw(12) << ms << std::setw(10) << baseMs / ms
+                      << (distances == reference ? "" : "  DISTANCES DIFFER") << '\n';
+        }
+    }
+
+    // findPathBFS from the console program, without the drawing: one cell
+    // at a time through a std::queue<Point>. Returns move counts, row-major.
+    static std::vector<int> queueBfs(const Grid& grid, const Point& source, Neighborhood neighborhood) {
+        std::vector<int> distance(static_cast<size_t>(grid.getRows()) * grid.getCols(), -1);
+        int moves = neighborhood == Neighborhood::Eight ? 8 : 4;
+        const int dr[] = {-1, 1, 0, 0, -1, -1, 1, 1};
+        const int dc[] = {0, 0, -1, 1, -1, 1, -1, 1};
+        std::queue<Point> q;
+        q.push(source);
+        distance[static_cast<size_t>(source.first) * grid.getCols() + source.second] = 0;
+        while (!q.empty()) {
+            Point current_pos = q.front(); q.pop();
+            int next_distance = distance[static_cast<size_t>(current_pos.first) * grid.getCols() + current_pos.second] + 1;
+            for (int i = 0; i < moves; ++i) {
+                int next_r = current_pos.first + dr[i];
+                int next_c = current_pos.second + dc[i];
+                if (!grid.isValid(next_r, next_c) || grid.isWall(grid.index(next_r, next_c))) continue;
+                int& d = distance[static_cast<size_t>(next_r) * grid.getCols() + next_c];
+                if (d < 0) {
+                    d = next_distance;
+                    q.push({next_r, next_c});
+                }
+            }
+        }
+        return distance;
+    }
+
+    // Whole-component floods from the start. Layers are exact BFS distances;
+    // the reachability flood only marks cells. Speedups are against queueBfs.
+    // Median of five runs of each method, as in the open-list benchmark.
+    void runBitboardBfsBenchmark() {
+        std::vector<MapCase> maps = standardMaps();
+        maps.insert(maps.begin(), {"open 1000x1000, no walls", makeScatterMap(1000, 1000, 0, 1)});
+        std::cout << "\n== Unweighted BFS floods ==\n";
+        std::cout << std::left << std::setw(30) << "Map" << std::setw(6) << "Nbhd" << std::right
+                  << std::setw(10) << "Queue ms" << std::setw(12) << "Layers ms" << std::setw(10) << "Speedup"
+                  << std::setw(11) << "Flood ms" << std::setw(10) << "Speedup" << '\n';
+        auto medianMs = [](const std::function<void()>& run) {
+            std::vector<double> times;
+            for (int i = 0; i < 5; ++i) {
+                auto begin = std::chrono::steady_clock::now();
+                run();
+                times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+            }
+            std::sort(times.begin(), times.end());
+            return times[times.size() / 2];
+        };
+        for (const auto& map : maps) {
+            for (Neighborhood neighborhood : {Neighborhood::Four, Neighborhood::Eight}) {
+                Point source = map.grid.getStart();
+                std::vector<int> reference;
+                double queueMs = medianMs([&]() { reference = queueBfs(map.grid, source, neighborhood); });
+
+                BitboardBfs bfs(neighborhood);
+                int reached = 0;
+                double floodMs = medianMs([&]() { reached = bfs.flood(map.grid, source); });
+                bool same = reached == static_cast<int>(reference.size() - std::count(reference.begin(), reference.end(), -1));
+
+                double layersMs = medianMs([&]() { bfs.run(map.grid, source); });
+                for (int r = 0; r < map.grid.getRows(); ++r) {
+                    for (int c = 0; c < map.grid.getCols(); ++c) {
+                        same = same && bfs.getDistance({r, c}) == reference[static_cast<size_t>(r) * map.grid.getCols() + c];
+                    }
+                }
+
+                std::cout << std::left << std::setw(30) << map.name << std::setw(6)
+                          << (neighborhood == Neighborhood::Four ? "4" : "8") << std::right << std::fixed
+                          << std::setprecision(2) << std::setw(10) << queueMs << std::setw(12) << layersMs
+                          << std::setw(10) << queueMs / layersMs << std::setw(11) << floodMs
+                          << std::setw(10) << queueMs / floodMs << (same ? "" : "  RESULTS DIFFER") << '\n';
+            }
+        }
+    }
+
+    // N units heading for one goal: one flow field plus N walks, against one
+    // A* query per unit. Then the cost of keeping the field current under edits.
+    void runFlowFieldBenchmark() {
+        Grid grid = makeScatterMap(1000, 1000, 20, 1);
+        const Point goal = grid.getEnd();
+        CellId goal_cell = grid.index(goal);
+        std::mt19937 rng(20);
+        auto randomOpenCell = [&]() {
+            while (true) {
+                Point p = {static_cast<int>(rng() % grid.getRows()), static_cast<int>(rng() % grid.getCols())};
+                if (grid.isReachable(grid.index(p), goal_cell)) return p;
+            }
+        };
+
+        std::cout << "\n== Flow field vs one A* per unit: open 1000x1000, 20% walls ==\n";
+        std::cout << std::left << std::setw(34) << "Method" << std::right << std::setw(8) << "Units"
+                  << std::setw(12) << "ms" << std::setw(14) << "Total cost" << '\n';
+        for (int units : {10, 100, 500}) {
+            std::vector<Point> agents(units);
+            for (Point& p : agents) p = randomOpenCell();
+
+            auto begin = std::chrono::steady_clock::now();
+            FlowField field;
+            field.build(grid, goal);
+            long long flowCost = 0;
+            for (Point p : agents) {
+                for (Point n = field.next(p); n != p; n = field.next(p)) {
+                    flowCost += (n.first != p.first && n.second != p.second) ? 14 : 10;
+                    p = n;
+                }
+            }
+            double flowMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+            begin = std::chrono::steady_clock::now();
+            AStarPathfinder astar;
+            long long astarCost = 0;
+            for (const Point& p : agents) {
+                astar.init(grid, p, goal);
+                while (astar.step() == AlgoState::Running) {}
+                astarCost += pathCost(astar.getPath());
+            }
+            double astarMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+            std::cout << std::left << std::setw(34) << "Flow field (build + walks)" << std::right << std::setw(8) << units
+                      << std::fixed << std::setprecision(2) << std::setw(12) << flowMs << std::setw(14) << flowCost << '\n';
+            std::cout << std::left << std::setw(34) << astar.getName() + " per unit" << std::right << std::setw(8) << units
+                      << std::setw(12) << astarMs << std::setw(14) << astarCost << '\n';
+        }
+
+        // Close and reopen random open cells, timing the local repairs.
+        FlowField field;
+        auto begin = std::chrono::steady_clock::now();
+        field.build(grid, goal);
+        double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        std::vector<Point> edited;
+        while (edited.size() < 200) {
+            Point p = randomOpenCell();
+            if (p != grid.getStart() && p != goal) edited.push_back(p);
+        }
+        // The repaired field must equal a fresh Dijkstra from the goal, checked
+        // untimed once all edited cells are closed and again once they are reopened.
+        auto matchesRebuild = [&]() {
+            std::vector<int> reference = computeDistances(grid, goal_cell);
+            for (int i = 0; i < grid.getCellCount(); ++i) {
+                if (field.getDistance(CellId(static_cast<std::uint32_t>(i))) != reference[i]) return false;
+            }
+            return true;
+        };
+        begin = std::chrono::steady_clock::now();
+        for (const Point& p : edited) {
+            grid.toggleWall(p);
+            field.onWallChanged(p);
+        }
+        double editMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        bool matches = matchesRebuild();
+        begin = std::chrono::steady_clock::now();
+        for (auto it = edited.rbegin(); it != edited.rend(); ++it) {
+            grid.toggleWall(*it);
+            field.onWallChanged(*it);
+        }
+        editMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        matches = matchesRebuild() && matches;
+        std::cout << std::fixed << std::setprecision(4) << "Field build " << buildMs << " ms; per edit (incl. grid upkeep) "
+                  << editMs / (2 * edited.size()) << " ms\n";
+        std::cout << "Flow field " << (matches ? "matches" : "DIFFERS FROM") << " computeDistances after " << edited.size()
+                  << " closes and again after reopening them\n";
+    }
+
+    std::vector<AgentTask> makeAgentTasks(const Grid& grid, int count, unsigned seed) {
+        std::mt19937 rng(seed);
+        CellId home = grid.index(grid.getStart());
+        std::vector<AgentTask> tasks;
+        std::vector<char> used(static_cast<size_t>(grid.getCellCount()), 0);
+        // Every agent takes two distinct cells of the start's component.
+        int free_cells = 0;
+        for (int r = 0; r < grid.getRows(); ++r) {
+            for (int c = 0; c < grid.getCols(); ++c) {
+                if (grid.isReachable(grid.index(r, c), home)) ++free_cells;
+            }
+        }
+        count = std::min(count, free_cells / 2);
+        auto pick = [&]() {
+            while (true) {
+                Point p = {static_cast<int>(rng() % grid.getRows()), static_cast<int>(rng() % grid.getCols())};
+                CellId id = grid.index(p);
+                if (grid.isReachable(id, home) && !used[id.value]) {
+                    used[id.value] = 1;
+                    return p;
+                }
+            }
+        };
+        for (int i = 0; i < count; ++i) {
+            AgentTask task;
+            task.start = pick();
+            task.goal = pick();
+            tasks.push_back(task);
+        }
+        return tasks;
+    }
+
+    // Independent A* paths replayed one cell per tick, against cooperative
+    // planning with full and windowed horizons.
+    void runCooperativeBenchmark() {
+        Grid grid = makeScatterMap(64, 64, 10, 21);
+        std::cout << "\n== Multi-agent planning: open 64x64, 10% walls ==\n";
+        std::cout << std::left << std::setw(34) << "Method" << std::right << std::setw(8) << "Agents"
+                  << std::setw(12) << "Plan ms" << std::setw(11) << "Conflicts" << std::setw(8) << "Failed"
+                  << std::setw(8) << "Ticks" << '\n';
+        for (int count : {20, 50, 100}) {
+            std::vector<AgentTask> tasks = makeAgentTasks(grid, count, 21 + count);
+
+            auto begin = std::chrono::steady_clock::now();
+            std::vector<std::vector<Point>> paths;
+            AStarPathfinder astar;
+            for (const AgentTask& task : tasks) {
+                astar.init(grid, task.start, task.goal);
+                while (astar.step() == AlgoState::Running) {}
+                paths.push_back(astar.getPath());
+            }
+            double astarMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            size_t ticks = 0;
+            for (const auto& path : paths) ticks = std::max(ticks, path.size() - 1);
+            int conflicts = 0;
+            std::vector<Point> before(tasks.size()), after(tasks.size());
+            for (size_t t = 1; t <= ticks; ++t) {
+                for (size_t a = 0; a < paths.size(); ++a) {
+                    before[a] = paths[a][std::min(t - 1, paths[a].size() - 1)];
+                    after[a] = paths[a][std::min(t, paths[a].size() - 1)];
+                }
+                conflicts += countConflicts(before, after);
+            }
+            std::cout << std::left << std::setw(34) << "Independent " + astar.getName() << std::right << std::setw(8) << count
+                      << std::fixed << std::setprecision(2) << std::setw(12) << astarMs << std::setw(11) << conflicts
+                      << std::setw(8) << 0 << std::setw(8) << ticks << '\n';
+
+            for (int window : {0, 16}) {
+                CooperativePlanner planner(window);
+                planner.reset(grid, tasks);
+                while (!planner.isFinished() && planner.getTime() < 2000) planner.tick();
+                std::string name = window ? "Cooperative A* (window " + std::to_string(window) + ")" : "Cooperative A*";
+                std::cout << std::left << std::setw(34) << name << std::right << std::setw(8) << count
+                          << std::setw(12) << planner.getPlanningMilliseconds() << std::setw(11) << planner.getConflictCount()
+                          << std::setw(8) << planner.getFailedPlanCount() << std::setw(8) << planner.getTime()
+                          << (planner.isFinished() ? "" : "  (not all arrived)") << '\n';
+            }
+        }
+
+        // Agent 0 parks in a corridor that agent 1 has to cross, so agent 1's
+        // first plan fails. It is planned first on the next tick, and agent 0
+        // waits in the side pocket until it has passed.
+        Grid corridor(2, 7);
+        corridor.createMazeFromLayout({"       ", "#### ##"});
+        std::vector<AgentTask> blocked = {{{0, 5}, {0, 2}}, {{0, 0}, {0, 6}}};
+        std::cout << "\n== Multi-agent planning: corridor, first plan blocked ==\n";
+        for (int window : {0, 16}) {
+            CooperativePlanner planner(window);
+            planner.reset(corridor, blocked);
+            while (!planner.isFinished() && planner.getTime() < 2000) planner.tick();
+            std::string name = window ? "Cooperative A* (window " + std::to_string(window) + ")" : "Cooperative A*";
+            std::cout << std::left << std::setw(34) << name << std::right << std::setw(8) << blocked.size()
+                      << std::setw(12) << planner.getPlanningMilliseconds() << std::setw(11) << planner.getConflictCount()
+                      << std::setw(8) << planner.getFailedPlanCount() << std::setw(8) << planner.getTime()
+                      << (planner.isFinished() ? "" : "  (not all arrived)") << '\n';
+        }
+    }
+
+    // When an anytime search reaches its first path, a 1.2 bound and the
+    // optimum, against an exact octile A* (ARA* with weight 1).
+    void runAnytimeBenchmark() {
+        for (const auto& map : standardMaps()) {
+            std::cout << "\n== Anytime search: " << map.name << " ==\n";
+            std::cout << std::left << std::setw(34) << "Milestone" << std::right << std::setw(12) << "Steps"
+                      << std::setw(12) << "ms" << std::setw(10) << "Cost" << std::setw(10) << "Bound" << '\n';
+            auto printMilestone = [](const std::string& name, long long steps, double ms, int cost, double bound) {
+                std::cout << std::left << std::setw(34) << name << std::right << std::setw(12) << steps << std::fixed
+                          << std::setprecision(2) << std::setw(12) << ms << std::setw(10) << cost << std::setw(10) << bound << '\n';
+            };
+
+            ARAStarPathfinder exact(1.0);
+            RunResult optimal = runToCompletion(exact, map.grid);
+            printMilestone("A* (octile, exact)", optimal.steps, optimal.milliseconds, optimal.pathCost, 1.0);
+
+            ARAStarPathfinder anytime;
+            anytime.init(map.grid);
+            auto begin = std::chrono::steady_clock::now();
+            bool first = true, within = false;
+            long long steps = 0;
+            AlgoState state;
+            while ((state = anytime.step()) == AlgoState::Running || state == AlgoState::PathFound) {
+                ++steps;
+                double bound = anytime.getSuboptimalityBound();
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+                if (first && !anytime.getPath().empty()) {
+                    first = false;
+                    printMilestone(anytime.getName() + " first path", steps, ms, pathCost(anytime.getPath()), bound);
+                }
+                if (!within && bound <= 1.2) {
+                    within = true;
+                    printMilestone(anytime.getName() + " bound <= 1.2", steps, ms, pathCost(anytime.getPath()), bound);
+                }
+                if (state == AlgoState::PathFound) {
+                    printMilestone(anytime.getName() + " optimal", steps, ms, pathCost(anytime.getPath()), bound);
+                    break;
+                }
+            }
+        }
+    }
+
+    // IDA* under a few table sizes against exact octile A* (ARA* at weight 1)
+    // and its per-cell arrays. Both find the optimal cost; IDA* pays for its
+    // memory ceiling in re-expansions, shown as a multiple of A*'s expansions.
+    void runMemoryBoundedBenchmark() {
+        Grid grid = makeScatterMap(1000, 1000, 20, 1);
+        std::cout << "\n== Memory-bounded search: open 1000x1000, 20% walls ==\n";
+        std::cout << std::left << std::setw(34) << "Algorithm" << std::right << std::setw(12) << "Expanded"
+                  << std::setw(10) << "x A*" << std::setw(8) << "Passes" << std::setw(10) << "Cost" << std::setw(12) << "ms"
+                  << std::setw(14) << "Peak KiB" << '\n';
+        long long baseline = 0;
+        auto printMemoryRow = [&baseline](const std::string& name, const RunResult& r, long long expanded, int passes, std::size_t bytes) {
+            std::cout << std::left << std::setw(34) << name << std::right << std::setw(12) << expanded << std::fixed
+                      << std::setprecision(2) << std::setw(10) << static_cast<double>(expanded) / std::max(1LL, baseline)
+                      << std::setw(8) << passes << std::setw(10) << (r.state == AlgoState::PathFound ? r.pathCost : -1)
+                      << std::setw(12) << r.milliseconds << std::setw(14) << bytes / 1024 << '\n';
+        };
+
+        // A* holds its arrays for every cell of the map plus the open list.
+        ARAStarPathfinder astar(1.0);
+        RunResult r = runToCompletion(astar, grid);
+        baseline = astar.getExpansionCount();
+        printMemoryRow("A* (octile, exact)", r, baseline, 1, astar.getPeakMemoryBytes());
+
+        for (std::size_t kib : {1024, 2048, 4096}) {
+            IDAStarPathfinder ida(kib * 1024);
+            r = runToCompletion(ida, grid);
+            printMemoryRow(ida.getName(), r, ida.getExpansionCount(), ida.getIterationCount(), ida.getPeakMemoryBytes());
+        }
+    }
+
+    // Frontier search keeps only the two open frontiers and re-solves each half
+    // of the path, against the A* variants and their per-cell arrays.
+    void runFrontierBenchmark() {
+        for (const auto& map : standardMaps()) {
+            std::cout << "\n== Frontier search: " << map.name << " ==\n";
+            std::cout << std::left << std::setw(34) << "Algorithm" << std::right << std::setw(12) << "Steps"
+                      << std::setw(10) << "Searches" << std::setw(10) << "Cost" << std::setw(12) << "ms" << std::setw(14) << "Peak KiB" << '\n';
+            auto printFrontierRow = [](const std::string& name, const RunResult& r, int searches, std::size_t bytes) {
+                std::cout << std::left << std::setw(34) << name << std::right << std::setw(12) << r.steps << std::setw(10) << searches
+                          << std::setw(10) << (r.state == AlgoState::PathFound ? r.pathCost : -1) << std::setw(12) << std::fixed
+                          << std::setprecision(2) << r.milliseconds << std::setw(14) << bytes / 1024 << '\n';
+            };
+
+            for (bool dijkstra : {false, true}) {
+                AStarPathfinder astar(dijkstra);
+                RunResult r = runToCompletion(astar, map.grid);
+                printFrontierRow(astar.getName(), r, 1,
+                                 astar.getSearchState().getMemoryBytes() + astar.getPeakOpenSize() * sizeof(PQElement));
+            }
+            FrontierSearchPathfinder frontier;
+            RunResult r = runToCompletion(frontier, map.grid);
+            printFrontierRow(frontier.getName(), r, frontier.getSearchCount(), frontier.getPeakMemoryBytes());
+        }
+    }
+
+    // Euclidean length of a polyline, and how often it changes direction.
+    static double polylineLength(const std::vector<Point>& path) {
+        double length = 0.0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            length += std::hypot(path[i].first - path[i - 1].first, path[i].second - path[i - 1].second);
+        }
+        return length;
+    }
+
+    static int countTurns(const std::vector<Point>& path) {
+        int turns = 0;
+        for (size_t i = 2; i < path.size(); ++i) {
+            Point a = {path[i - 1].first - path[i - 2].first, path[i - 1].second - path[i - 2].second};
+            Point b = {path[i].first - path[i - 1].first, path[i].second - path[i - 1].second};
+            if (static_cast<long long>(a.first) * b.second != static_cast<long long>(a.second) * b.first ||
+                a.first * b.first + a.second * b.second < 0) {
+                ++turns;
+            }
+        }
+        return turns;
+    }
+
+    // Any-angle paths against grid A* and Dijkstra: length in cells, the
+    // corners an agent would have to steer round, and the cost of the
+    // line-of-sight checks.
+    void runAnyAngleBenchmark() {
+        for (const auto& map : standardMaps()) {
+            std::cout << "\n== Any-angle: " << map.name << " ==\n";
+            std::cout << std::left << std::setw(34) << "Algorithm" << std::right << std::setw(12) << "Steps"
+                      << std::setw(12) << "LOS checks" << std::setw(12) << "Length" << std::setw(8) << "Turns"
+                      << std::setw(12) << "ms" << '\n';
+            auto printAnyAngleRow = [](const std::string& name, const RunResult& r, long long checks, double length, int turns) {
+                std::cout << std::left << std::setw(34) << name << std::right << std::setw(12) << r.steps << std::setw(12) << checks
+                          << std::fixed << std::setprecision(1) << std::setw(12) << length << std::setw(8) << turns
+                          << std::setprecision(2) << std::setw(12) << r.milliseconds << '\n';
+            };
+
+            for (bool dijkstra : {false, true}) {
+                AStarPathfinder grid(dijkstra);
+                RunResult r = runToCompletion(grid, map.grid);
+                printAnyAngleRow(grid.getName(), r, 0, polylineLength(grid.getPath()), countTurns(grid.getPath()));
+            }
+            for (bool lazy : {false, true}) {
+                ThetaStarPathfinder theta(lazy);
+                RunResult r = runToCompletion(theta, map.grid);
+                printAnyAngleRow(theta.getName(), r, theta.getLineOfSightChecks(), theta.getPathLength(),
+                                 std::max(0, static_cast<int>(theta.getWaypoints().size()) - 2));
+            }
+        }
+    }
+
+    void runAll() {
+        runOpenListBenchmark();
+        runJumpPointBenchmark();
+        runReplanningBenchmark();
+        runHierarchicalBenchmark();
+        runUnreachableBenchmark();
+        runLandmarkBenchmark();
+        runBatchBenchmark();
+        runParallelBidirectionalBenchmark();
+        runDeltaSteppingBenchmark();
+        runBitboardBfsBenchmark();
+        runFlowFieldBenchmark();
+        runCooperativeBenchmark();
+        runAnytimeBenchmark();
+        runMemoryBoundedBenchmark();
+        runFrontierBenchmark();
+        runAnyAngleBenchmark();
+    }
+}
\ No newline at end of file
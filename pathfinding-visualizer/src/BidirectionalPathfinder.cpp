@@ -1,32 +1,41 @@
 #include "BidirectionalPathfinder.h"
+#include "Bits.h"
 #include <cmath>
 
-BidirectionalPathfinder::BidirectionalPathfinder() {
+BidirectionalPathfinder::BidirectionalPathfinder(OpenListKind openList, std::shared_ptr<const LandmarkHeuristic> landmarks)
+    : m_pq_fwd(openList), m_pq_bwd(openList), m_landmarks(std::move(landmarks)) {
     m_name = "Bidirectional A*";
+    if (m_landmarks) m_name += " + ALT";
+    m_name += getOpenListLabel(openList);
 }
 
 std::string BidirectionalPathfinder::getName() const { return m_name; }
 
-void BidirectionalPathfinder::init(Grid& grid) {
+void BidirectionalPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
     m_grid = &grid;
-    m_grid->reset();
-    m_start = m_grid->getStart();
-    m_end = m_grid->getEnd();
-    m_pq_fwd = {};
-    m_pq_bwd = {};
+    m_state.resize(m_grid->getCellCount());
+    m_state.reset();
+    m_start = start;
+    m_end = end;
+    m_pq_fwd.reset(m_grid->getCellCount());
+    m_pq_bwd.reset(m_grid->getCellCount());
     m_path.clear();
-    m_meetingPoint = {-1, -1};
+    m_meetingPoint = CellId::invalid();
     m_bestPathCost = std::numeric_limits<int>::max();
 
-    m_grid->getNode(m_start.first, m_start.second).g_score = 0;
-    m_pq_fwd.push({heuristic(m_start, m_end), m_start});
+    CellId start_cell = m_grid->index(m_start);
+    CellId end_cell = m_grid->index(m_end);
+    if (!m_grid->isReachable(start_cell, end_cell)) return;
+
+    m_state.setGScore(start_cell, 0);
+    m_pq_fwd.push(start_cell, heuristic(start_cell, m_start, true));
     
-    m_grid->getNode(m_end.first, m_end.second).g_score_bwd = 0;
-    m_pq_bwd.push({heuristic(m_start, m_end), m_end});
+    m_state.setGScoreBwd(end_cell, 0);
+    m_pq_bwd.push(end_cell, heuristic(end_cell, m_end, false));
 }
 
 void BidirectionalPathfinder::onWallChanged(const Point& pos) {
-    init(*m_grid);
+    init(*m_grid, m_start, m_end);
 }
 
 AlgoState BidirectionalPathfinder::step() {
@@ -35,36 +44,36 @@ AlgoState BidirectionalPathfinder::step() {
 
     // --- Forward Step ---
     if (!m_pq_fwd.empty()) {
-        Point curr_pos = m_pq_fwd.top().second;
-        m_pq_fwd.pop();
-        Node& curr_node = m_grid->getNode(curr_pos.first, curr_pos.second);
-        if (!curr_node.visited_fwd) {
-            curr_node.visited_fwd = true;
-            m_grid->setCurrentlyProcessing(curr_pos);
-
-            if (curr_node.visited_bwd) { // Met the other search
-                int pathCost = curr_node.g_score + curr_node.g_score_bwd;
+        CellId curr = m_pq_fwd.pop();
+        if (!m_state.isVisitedFwd(curr)) {
+            m_state.setVisitedFwd(curr);
+            Point curr_pos = m_grid->toPoint(curr);
+            m_currentlyProcessing = curr_pos;
+            int curr_g = m_state.getGScore(curr);
+
+            if (m_state.isVisitedBwd(curr)) { // Met the other search
+                int pathCost = curr_g + m_state.getGScoreBwd(curr);
                 if(pathCost < m_bestPathCost) {
                     m_bestPathCost = pathCost;
-                    m_meetingPoint = curr_pos;
+                    m_meetingPoint = curr;
                 }
             }
-            if (!m_pq_fwd.empty() && !m_pq_bwd.empty() && m_pq_fwd.top().first + m_pq_bwd.top().first >= m_bestPathCost) {
-                 m_path = m_grid->reconstructPath(true, m_meetingPoint);
+            if (!m_pq_fwd.empty() && !m_pq_bwd.empty() && m_pq_fwd.topPriority() + m_pq_bwd.topPriority() >= m_bestPathCost) {
+                 m_path = m_state.reconstructPath(*m_grid, m_meetingPoint, true);
                  return AlgoState::PathFound;
             }
 
-            for (int i = 0; i < 8; ++i) {
-                Point neighbor_pos = {curr_pos.first + dr[i], curr_pos.second + dc[i]};
-                if (m_grid->isValid(neighbor_pos.first, neighbor_pos.second) && !m_grid->getNode(neighbor_pos.first, neighbor_pos.second).is_wall) {
-                    int cost = (i < 4) ? 10 : 14;
-                    Node& neighbor_node = m_grid->getNode(neighbor_pos.first, neighbor_pos.second);
-                    int tentative_g_score = curr_node.g_score + cost;
-                    if (tentative_g_score < neighbor_node.g_score) {
-                        neighbor_node.parent = curr_pos;
-                        neighbor_node.g_score = tentative_g_score;
-                        m_pq_fwd.push({tentative_g_score + heuristic(neighbor_pos, m_end), neighbor_pos});
-                    }
+            for (unsigned open_dirs = m_grid->getNeighborMask(curr); open_dirs; open_dirs &= open_dirs - 1) {
+                int i = bits::countTrailingZeros(open_dirs);
+                CellId neighbor = curr + m_grid->getNeighborOffset(i);
+
+                int cost = (i < 4) ? 10 : 14;
+                int tentative_g_score = curr_g + cost;
+                if (tentative_g_score < m_state.getGScore(neighbor)) {
+                    m_state.setParent(neighbor, curr);
+                    m_state.setGScore(neighbor, tentative_g_score);
+                    Point neighbor_pos = {curr_pos.first + dr[i], curr_pos.second + dc[i]};
+                    m_pq_fwd.push(neighbor, tentative_g_score + heuristic(neighbor, neighbor_pos, true), tentative_g_score);
                 }
             }
         }
@@ -72,34 +81,35 @@ AlgoState BidirectionalPathfinder::step() {
 
     // --- Backward Step ---
     if (!m_pq_bwd.empty()) {
-        Point curr_pos = m_pq_bwd.top().second;
-        m_pq_bwd.pop();
-        Node& curr_node = m_grid->getNode(curr_pos.first, curr_pos.second);
-        if (!curr_node.visited_bwd) {
-            curr_node.visited_bwd = true;
-            if (curr_node.visited_fwd) { // Met the other search
-                int pathCost = curr_node.g_score + curr_node.g_score_bwd;
+        CellId curr = m_pq_bwd.pop();
+        if (!m_state.isVisitedBwd(curr)) {
+            m_state.setVisitedBwd(curr);
+            Point curr_pos = m_grid->toPoint(curr);
+            int curr_g = m_state.getGScoreBwd(curr);
+
+            if (m_state.isVisitedFwd(curr)) { // Met the other search
+                int pathCost = m_state.getGScore(curr) + curr_g;
                 if (pathCost < m_bestPathCost) {
                     m_bestPathCost = pathCost;
-                    m_meetingPoint = curr_pos;
+                    m_meetingPoint = curr;
                 }
             }
-             if (!m_pq_fwd.empty() && !m_pq_bwd.empty() && m_pq_fwd.top().first + m_pq_bwd.top().first >= m_bestPathCost) {
-                 m_path = m_grid->reconstructPath(true, m_meetingPoint);
+             if (!m_pq_fwd.empty() && !m_pq_bwd.empty() && m_pq_fwd.topPriority() + m_pq_bwd.topPriority() >= m_bestPathCost) {
+                 m_path = m_state.reconstructPath(*m_grid, m_meetingPoint, true);
                  return AlgoState::PathFound;
             }
 
-            for (int i = 0; i < 8; ++i) {
-                Point neighbor_pos = {curr_pos.first + dr[i], curr_pos.second + dc[i]};
-                if (m_grid->isValid(neighbor_pos.first, neighbor_pos.second) && !m_grid->getNode(neighbor_pos.first, neighbor_pos.second).is_wall) {
-                    int cost = (i < 4) ? 10 : 14;
-                    Node& neighbor_node = m_grid->getNode(neighbor_pos.first, neighbor_pos.second);
-                    int tentative_g_score = curr_node.g_score_bwd + cost;
-                    if (tentative_g_score < neighbor_node.g_score_bwd) {
-                        neighbor_node.parent_bwd = curr_pos;
-                        neighbor_node.g_score_bwd = tentative_g_score;
-                        m_pq_bwd.push({tentative_g_score + heuristic(neighbor_pos, m_start), neighbor_pos});
-                    }
+            for (unsigned open_dirs = m_grid->getNeighborMask(curr); open_dirs; open_dirs &= open_dirs - 1) {
+                int i = bits::countTrailingZeros(open_dirs);
+                CellId neighbor = curr + m_grid->getNeighborOffset(i);
+
+                int cost = (i < 4) ? 10 : 14;
+                int tentative_g_score = curr_g + cost;
+                if (tentative_g_score < m_state.getGScoreBwd(neighbor)) {
+                    m_state.setParentBwd(neighbor, curr);
+                    m_state.setGScoreBwd(neighbor, tentative_g_score);
+                    Point neighbor_pos = {curr_pos.first + dr[i], curr_pos.second + dc[i]};
+                    m_pq_bwd.push(neighbor, tentative_g_score + heuristic(neighbor, neighbor_pos, false), tentative_g_score);
                 }
             }
         }
@@ -108,6 +118,8 @@ AlgoState BidirectionalPathfinder::step() {
     return AlgoState::Running;
 }
 
-int BidirectionalPathfinder::heuristic(const Point& a, const Point& b) {
-    return (std::abs(a.first - b.first) + std::abs(a.second - b.second)) * 10;
+int BidirectionalPathfinder::heuristic(CellId cell, const Point& pos, bool forward) const {
+    const Point& target = forward ? m_end : m_start;
+    if (m_landmarks) return m_landmarks->estimate(cell, m_grid->index(target));
+    return (std::abs(pos.first - target.first) + std::abs(pos.second - target.second)) * 10;
 }
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "BitboardBfs.h"
+#include "Bits.h"
+#include "Directions.h"
+#include <algorithm>
+
+std::uint64_t BitboardBfs::spread(const std::uint64_t* frontier, int j) const {
+    std::uint64_t word = frontier[j];
+    std::uint64_t east = word << 1 | (j > 0 ? frontier[j - 1] >> 63 : 0);
+    std::uint64_t west = word >> 1 | (j + 1 < m_words ? frontier[j + 1] << 63 : 0);
+    return east | west;
+}
+
+void BitboardBfs::load(const Grid& grid) {
+    m_rows = grid.getRows();
+    m_cols = grid.getCols();
+    m_words = (m_cols + 63) / 64;
+    const size_t boardSize = static_cast<size_t>(m_rows + 2) * m_words;
+
+    // Copy the open cells row by row; bits past the last column stay clear.
+    m_open.assign(boardSize, 0);
+    for (int r = 0; r < m_rows; ++r) {
+        std::uint64_t* open = row(m_open, r + 1);
+        int base = static_cast<int>(grid.index(r, 0).value);
+        for (int j = 0; j < m_words; ++j) {
+            int count = std::min(64, m_cols - 64 * j);
+            std::uint64_t mask = count == 64 ? ~0ULL : (1ULL << count) - 1;
+            open[j] = ~grid.getWallWord(base + 64 * j) & mask;
+        }
+    }
+    m_seen.assign(boardSize, 0);
+    m_layers = 0;
+}
+
+int BitboardBfs::run(const Grid& grid, const Point& source, const Point& target) {
+    load(grid);
+    const size_t boardSize = m_open.size();
+    m_reach.assign(boardSize, 0);
+    m_touchedLayer.assign(boardSize, 0);
+    m_log.clear();
+    m_layerStart.assign(1, 0);
+    m_distanceBuilt = false;
+
+    if (!grid.isValid(source.first, source.second) || grid.isWall(grid.index(source))) return -1;
+    bool wholeComponent = !grid.isValid(target.first, target.second);
+    if (!wholeComponent && grid.isWall(grid.index(target))) return -1;
+
+    int index = (source.first + 1) * m_words + (source.second >> 6);
+    std::uint64_t bit = 1ULL << (source.second & 63);
+    m_seen[index] = bit;
+    m_log.push_back({index, bit});
+    m_layerStart.push_back(m_log.size());
+    if (source == target) return 0;
+
+    const bool eight = m_neighborhood == Neighborhood::Eight;
+    for (int layer = 1;; ++layer) {
+        // Each frontier word ORs its moves into the words they land in; the
+        // padding rows absorb moves off the top and bottom.
+        m_touched.clear();
+        auto touch = [&](int i, std::uint64_t moves) {
+            if (m_touchedLayer[i] != layer) {
+                m_touchedLayer[i] = layer;
+                m_reach[i] = moves;
+                m_touched.push_back(i);
+            } else {
+                m_reach[i] |= moves;
+            }
+        };
+        const size_t first = m_layerStart[layer - 1], last = m_layerStart[layer];
+        for (size_t k = first; k < last; ++k) {
+            int i = m_log[k].index;
+            std::uint64_t bits = m_log[k].bits;
+            std::uint64_t sideways = bits << 1 | bits >> 1;
+            std::uint64_t vertical = eight ? bits | sideways : bits;
+            touch(i, sideways);
+            touch(i - m_words, vertical);
+            touch(i + m_words, vertical);
+            // Edge bits spill into the neighbouring word of the same rows.
+            int w = i % m_words;
+            if ((bits >> 63) && w + 1 < m_words) {
+                touch(i + 1, 1);
+                if (eight) {
+                    touch(i + 1 - m_words, 1);
+                    touch(i + 1 + m_words, 1);
+                }
+            }
+            if ((bits & 1) && w > 0) {
+                touch(i - 1, 1ULL << 63);
+                if (eight) {
+                    touch(i - 1 - m_words, 1ULL << 63);
+                    touch(i - 1 + m_words, 1ULL << 63);
+                }
+            }
+        }
+
+        for (int i : m_touched) {
+            std::uint64_t fresh = m_reach[i] & m_open[i] & ~m_seen[i];
+            if (!fresh) continue;
+            m_seen[i] |= fresh;
+            m_log.push_back({i, fresh});
+        }
+        if (m_log.size() == last) break;
+        m_layerStart.push_back(m_log.size());
+        m_layers = layer;
+        if (!wholeComponent && isReached(target)) return layer;
+    }
+    return wholeComponent ? m_layers : -1;
+}
+
+namespace {
+    // Kogge-Stone fills: grow seeds east (towards higher bits) or west
+    // through the open bits of one word.
+    std::uint64_t fillEast(std::uint64_t seeds, std::uint64_t open) {
+        seeds |= open & (seeds << 1); open &= open << 1;
+        seeds |= open & (seeds << 2); open &= open << 2;
+        seeds |= open & (seeds << 4); open &= open << 4;
+        seeds |= open & (seeds << 8); open &= open << 8;
+        seeds |= open & (seeds << 16); open &= open << 16;
+        return seeds | (open & (seeds << 32));
+    }
+
+    std::uint64_t fillWest(std::uint64_t seeds, std::uint64_t open) {
+        seeds |= open & (seeds >> 1); open &= open >> 1;
+        seeds |= open & (seeds >> 2); open &= open >> 2;
+        seeds |= open & (seeds >> 4); open &= open >> 4;
+        seeds |= open & (seeds >> 8); open &= open >> 8;
+        seeds |= open & (seeds >> 16); open &= open >> 16;
+        return seeds | (open & (seeds >> 32));
+    }
+}
+
+int BitboardBfs::flood(const Grid& grid, const Point& source) {
+    load(grid);
+    // No layers in this mode.
+    m_log.clear();
+    m_layerStart.assign(1, 0);
+    m_distanceBuilt = false;
+    if (!grid.isValid(source.first, source.second) || grid.isWall(grid.index(source))) return 0;
+
+    row(m_seen, source.first + 1)[source.second >> 6] = 1ULL << (source.second & 63);
+    m_queued.assign(m_rows + 2, 0);
+    std::vector<int> worklist = {source.first + 1};
+    m_queued[source.first + 1] = 1;
+    std::vector<std::uint64_t> reach(m_words);
+    bool first = true; // the source row spreads even if its fill added nothing
+    const bool eight = m_neighborhood == Neighborhood::Eight;
+    while (!worklist.empty()) {
+        int q = worklist.back();
+        worklist.pop_back();
+        m_queued[q] = 0;
+
+        // Seeds from the row itself and from the rows above and below, grown
+        // along every run they touch: eastwards carrying over word borders,
+        // then westwards.
+        const std::uint64_t* above = row(m_seen, q - 1);
+        const std::uint64_t* below = row(m_seen, q + 1);
+        const std::uint64_t* open = row(m_open, q);
+        std::uint64_t* seen = row(m_seen, q);
+        std::uint64_t carry = 0;
+        for (int w = 0; w < m_words; ++w) {
+            std::uint64_t seeds = seen[w] | above[w] | below[w];
+            if (eight) seeds |= spread(above, w) | spread(below, w);
+            reach[w] = fillEast((seeds | carry) & open[w], open[w]);
+            carry = reach[w] >> 63;
+        }
+        bool grew = false;
+        carry = 0;
+        for (int w = m_words - 1; w >= 0; --w) {
+            reach[w] = fillWest(reach[w] | (carry & open[w]), open[w]);
+            carry = reach[w] << 63;
+            if (reach[w] != seen[w]) {
+                seen[w] = reach[w];
+                grew = true;
+            }
+        }
+        if (!grew && !first) continue;
+        first = false;
+        for (int n : {q - 1, q + 1}) {
+            if (n >= 1 && n <= m_rows && !m_queued[n]) {
+                m_queued[n] = 1;
+                worklist.push_back(n);
+            }
+        }
+    }
+
+    int reached = 0;
+    for (std::uint64_t word : m_seen) reached += bits::popCount(word);
+    return reached;
+}
+
+int BitboardBfs::findLayer(const Point& p) const {
+    int index = (p.first + 1) * m_words + (p.second >> 6);
+    std::uint64_t bit = 1ULL << (p.second & 63);
+    for (size_t layer = 0; layer + 1 < m_layerStart.size(); ++layer) {
+        for (size_t k = m_layerStart[layer]; k < m_layerStart[layer + 1]; ++k) {
+            if (m_log[k].index == index && (m_log[k].bits & bit)) return static_cast<int>(layer);
+        }
+    }
+    return -1;
+}
+
+int BitboardBfs::getDistance(const Point& p) const {
+    if (!m_distanceBuilt) {
+        m_distance.assign(static_cast<size_t>(m_rows) * m_cols, -1);
+        for (size_t layer = 0; layer + 1 < m_layerStart.size(); ++layer) {
+            for (size_t k = m_layerStart[layer]; k < m_layerStart[layer + 1]; ++k) {
+                int q = m_log[k].index / m_words, w = m_log[k].index % m_words;
+                int* distance = &m_distance[static_cast<size_t>(q - 1) * m_cols + 64 * w];
+                for (std::uint64_t b = m_log[k].bits; b; b &= b - 1) distance[bits::countTrailingZeros(b)] = static_cast<int>(layer);
+            }
+        }
+        m_distanceBuilt = true;
+    }
+    return m_distance[static_cast<size_t>(p.first) * m_cols + p.second];
+}
+
+std::vector<Point> BitboardBfs::getPath(const Point& target) const {
+    std::vector<Point> path;
+    if (target.first < 0 || target.first >= m_rows || target.second < 0 || target.second >= m_cols) return path;
+    int d = findLayer(target);
+    if (d < 0) return path;
+
+    // Each step looks through the previous layer's words for a neighbour.
+    const int moves = m_neighborhood == Neighborhood::Eight ? dirs::kCount : 4;
+    Point current = target;
+    path.push_back(current);
+    for (; d > 0; --d) {
+        bool found = false;
+        for (size_t k = m_layerStart[d - 1]; k < m_layerStart[d] && !found; ++k) {
+            const LayerWord& lw = m_log[k];
+            for (int i = 0; i < moves && !found; ++i) {
+                Point p = {current.first + dirs::kDr[i], current.second + dirs::kDc[i]};
+                if (p.first < 0 || p.first >= m_rows || p.second < 0 || p.second >= m_cols) continue;
+                if ((p.first + 1) * m_words + (p.second >> 6) != lw.index) continue;
+                if ((lw.bits >> (p.second & 63)) & 1) {
+                    current = p;
+                    found = true;
+                }
+            }
+        }
+        path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "CooperativePlanner.h"
+#include "Bits.h"
+#include "Directions.h"
+#include "SearchState.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <functional>
+#include <queue>
+
+constexpr int ReservationTable::kNone;
+constexpr int CooperativePlanner::kMaxExpansions;
+
+void ReservationTable::clear() {
+    m_count = 0;
+    if (++m_generation != 0) return;
+    // Stamp counter wrapped: old entries could look live again, so sweep once.
+    m_generation = 1;
+    for (Entry& e : m_entries) e.stamp = 0;
+}
+
+void ReservationTable::set(CellId cell, int time, int value) {
+    if ((m_count + 1) * 2 > m_entries.size()) grow();
+    std::uint64_t key = makeKey(cell, time);
+    std::size_t mask = m_entries.size() - 1;
+    for (std::size_t i = home(key);; i = (i + 1) & mask) {
+        Entry& e = m_entries[i];
+        if (e.stamp != m_generation) {
+            e = {key, value, m_generation};
+            ++m_count;
+            return;
+        }
+        if (e.key == key) {
+            e.value = value;
+            return;
+        }
+    }
+}
+
+int ReservationTable::get(CellId cell, int time) const {
+    std::uint64_t key = makeKey(cell, time);
+    std::size_t mask = m_entries.size() - 1;
+    for (std::size_t i = home(key);; i = (i + 1) & mask) {
+        const Entry& e = m_entries[i];
+        if (e.stamp != m_generation) return kNone;
+        if (e.key == key) return e.value;
+    }
+}
+
+void ReservationTable::grow() {
+    std::vector<Entry> old(m_entries.size() * 2, Entry{0, 0, 0});
+    old.swap(m_entries);
+    std::uint32_t live = m_generation;
+    m_generation = 1;
+    m_count = 0;
+    for (const Entry& e : old) {
+        if (e.stamp != live) continue;
+        std::size_t mask = m_entries.size() - 1;
+        std::size_t i = home(e.key);
+        while (m_entries[i].stamp == m_generation) i = (i + 1) & mask;
+        m_entries[i] = {e.key, e.value, m_generation};
+        ++m_count;
+    }
+}
+
+int countConflicts(const std::vector<Point>& before, const std::vector<Point>& after) {
+    int conflicts = 0;
+    for (size_t i = 0; i < after.size(); ++i) {
+        for (size_t j = i + 1; j < after.size(); ++j) {
+            if (after[i] == after[j]) ++conflicts;
+            else if (after[i] == before[j] && after[j] == before[i]) ++conflicts;
+        }
+    }
+    return conflicts;
+}
+
+void CooperativePlanner::reset(const Grid& grid, const std::vector<AgentTask>& agents) {
+    m_grid = &grid;
+    m_agents = agents;
+    m_positions.clear();
+    for (const AgentTask& a : agents) m_positions.push_back(a.start);
+
+    // One flow field per distinct goal doubles as the exact heuristic.
+    m_fields.clear();
+    m_fieldOf.assign(agents.size(), 0);
+    for (size_t a = 0; a < agents.size(); ++a) {
+        size_t f = 0;
+        while (f < m_fields.size() && m_fields[f]->getGoal() != agents[a].goal) ++f;
+        if (f == m_fields.size()) {
+            m_fields.emplace_back(new FlowField());
+            m_fields.back()->build(grid, agents[a].goal);
+        }
+        m_fieldOf[a] = static_cast<int>(f);
+    }
+
+    m_order.resize(agents.size());
+    for (size_t a = 0; a < agents.size(); ++a) m_order[a] = static_cast<int>(a);
+    m_plans.assign(agents.size(), {});
+    m_planStart = 0;
+    m_nextReplan = 0;
+    m_time = 0;
+    m_planningMs = 0.0;
+    m_conflicts = 0;
+    m_failedPlans = 0;
+}
+
+int CooperativePlanner::tick() {
+    if (isFinished()) return 0;
+    if (m_time >= m_nextReplan) replan();
+
+    std::vector<Point> before = m_positions;
+    for (size_t a = 0; a < m_agents.size(); ++a) {
+        const std::vector<CellId>& plan = m_plans[a];
+        size_t k = std::min(static_cast<size_t>(m_time + 1 - m_planStart), plan.size() - 1);
+        m_positions[a] = m_grid->toPoint(plan[k]);
+    }
+    ++m_time;
+    int conflicts = countConflicts(before, m_positions);
+    m_conflicts += conflicts;
+    return conflicts;
+}
+
+bool CooperativePlanner::isFinished() const {
+    for (size_t a = 0; a < m_agents.size(); ++a) {
+        if (m_positions[a] != m_agents[a].goal) return false;
+    }
+    return true;
+}
+
+void CooperativePlanner::replan() {
+    auto begin = std::chrono::steady_clock::now();
+    const int cells = m_grid->getCellCount();
+    m_reserved.clear();
+    m_lastReserved.assign(static_cast<size_t>(cells), -1);
+    m_parkedFrom.assign(static_cast<size_t>(cells), INT_MAX);
+    m_parkedBy.assign(static_cast<size_t>(cells), ReservationTable::kNone);
+    m_planStart = m_time;
+
+    std::stable_partition(m_order.begin(), m_order.end(), [this](int a) { return m_positions[a] != m_agents[a].goal; });
+    std::vector<char> failed(m_agents.size(), 0);
+    for (int a : m_order) {
+        if (planAgent(a)) continue;
+        // No plan: the agent stays put and the later agents route around it.
+        ++m_failedPlans;
+        failed[a] = 1;
+        CellId here = m_grid->index(m_positions[a]);
+        m_plans[a].assign(1, here);
+        reserve(a, m_plans[a]);
+        m_parkedFrom[here.value] = m_time;
+        m_parkedBy[here.value] = a;
+    }
+    m_nextReplan = m_window > 0 ? m_time + std::max(1, m_window / 2) : INT_MAX;
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+        // Whoever blocked it has moved on by the next tick, and planning it
+        // first then makes the others give way instead.
+        std::stable_partition(m_order.begin(), m_order.end(), [&failed](int a) { return failed[a] != 0; });
+        m_nextReplan = m_time + 1;
+    }
+    m_planningMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+bool CooperativePlanner::isFree(int agent, CellId from, CellId to, int t) const {
+    int holder = m_reserved.get(to, t + 1);
+    if (holder != ReservationTable::kNone && holder != agent) return false;
+    if (m_parkedFrom[to.value] <= t + 1 && m_parkedBy[to.value] != agent) return false;
+    if (to == from) return true;
+    // Swap: whoever holds `to` now must not be moving into `from`.
+    int other = m_reserved.get(to, t);
+    return other == ReservationTable::kNone || other == agent || m_reserved.get(from, t + 1) != other;
+}
+
+bool CooperativePlanner::planAgent(int agent) {
+    const FlowField& field = *m_fields[m_fieldOf[agent]];
+    CellId start = m_grid->index(m_positions[agent]);
+    CellId goal = m_grid->index(m_agents[agent].goal);
+    if (field.getDistance(start) == SearchState::kInfinity) return false;
+    const int horizon = m_window > 0 ? m_time + m_window : INT_MAX;
+
+    // Open entries: f in the high word, then larger g first, then node index.
+    using Entry = std::pair<std::uint64_t, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    auto push = [&](CellId cell, int time, int g, int parent) {
+        int index = static_cast<int>(m_nodes.size());
+        m_nodes.push_back({cell, time, g, parent});
+        m_seen.set(cell, time, index);
+        std::uint64_t f = static_cast<std::uint64_t>(g) + field.getDistance(cell);
+        open.push({f << 32 | (0xFFFFFFFFu - static_cast<std::uint32_t>(g)), index});
+    };
+
+    m_nodes.clear();
+    m_seen.clear();
+    push(start, m_time, 0, -1);
+    int expansions = 0;
+    while (!open.empty() && expansions < kMaxExpansions) {
+        int index = open.top().second;
+        open.pop();
+        Node node = m_nodes[index];
+        if (m_seen.get(node.cell, node.time) != index) continue; // superseded
+        ++expansions;
+
+        bool parked = node.cell == goal && node.time >= m_lastReserved[goal.value];
+        if (parked || node.time >= horizon) {
+            std::vector<CellId>& plan = m_plans[agent];
+            plan.assign(static_cast<size_t>(node.time - m_time + 1), CellId::invalid());
+            for (int i = index; i >= 0; i = m_nodes[i].parent) plan[m_nodes[i].time - m_time] = m_nodes[i].cell;
+            reserve(agent, plan);
+            if (parked) {
+                m_parkedFrom[goal.value] = node.time;
+                m_parkedBy[goal.value] = agent;
+            }
+            return true;
+        }
+
+        // Waiting, then the open neighbours.
+        unsigned moves = m_grid->getNeighborMask(node.cell) | 1u << dirs::kCount;
+        for (; moves; moves &= moves - 1) {
+            int i = bits::countTrailingZeros(moves);
+            CellId next = i == dirs::kCount ? node.cell : node.cell + m_grid->getNeighborOffset(i);
+            if (!isFree(agent, node.cell, next, node.time)) continue;
+            int g = node.g + (i < 4 || i == dirs::kCount ? 10 : 14);
+            int seen = m_seen.get(next, node.time + 1);
+            if (seen != ReservationTable::kNone && m_nodes[seen].g <= g) continue;
+            push(next, node.time + 1, g, index);
+        }
+    }
+    return false;
+}
+
+void CooperativePlanner::reserve(int agent, const std::vector<CellId>& plan) {
+    for (size_t k = 0; k < plan.size(); ++k) {
+        int t = m_planStart + static_cast<int>(k);
+        m_reserved.set(plan[k], t, agent);
+        m_lastReserved[plan[k].value] = std::max(m_lastReserved[plan[k].value], t);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "DeltaStepping.h"
+#include "Bits.h"
+#include "OpenList.h"
+#include "SearchState.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+    const int kMaxStepCost = 14;
+    const std::size_t kChunkSize = 256;
+}
+
+std::vector<int> computeDistances(const Grid& grid, CellId source) {
+    std::vector<int> distance(static_cast<size_t>(grid.getCellCount()), SearchState::kInfinity);
+    if (grid.isWall(source)) return distance;
+    BucketQueue open;
+    open.reset(grid.getCellCount());
+    distance[source.value] = 0;
+    open.push(source, 0);
+    while (!open.empty()) {
+        CellId current = open.pop();
+        int current_g = distance[current.value];
+        for (unsigned open_dirs = grid.getNeighborMask(current); open_dirs; open_dirs &= open_dirs - 1) {
+            int i = bits::countTrailingZeros(open_dirs);
+            CellId neighbor = current + grid.getNeighborOffset(i);
+            int g = current_g + (i < 4 ? 10 : 14);
+            if (g < distance[neighbor.value]) {
+                distance[neighbor.value] = g;
+                open.push(neighbor, g);
+            }
+        }
+    }
+    return distance;
+}
+
+DeltaStepping::DeltaStepping(int threads, int delta)
+    : m_delta(std::max(1, delta)), m_pool(threads) {
+    // Pending distances never exceed the settled bucket's by more than one
+    // step, so a ring of this many buckets never wraps onto a live one.
+    int ring = kMaxStepCost / m_delta + 2;
+    m_buckets.assign(m_pool.size(), std::vector<std::vector<CellId>>(ring));
+    m_frontier.resize(m_pool.size());
+    m_settled.resize(m_pool.size());
+}
+
+std::vector<int> DeltaStepping::run(const Grid& grid, CellId source) {
+    const int cells = grid.getCellCount();
+    const int workers = m_pool.size();
+    const int ring = static_cast<int>(m_buckets[0].size());
+    m_rounds = 0;
+
+    // distance: best known so far. expanded: the distance a cell's light edges
+    // were last relaxed at, so duplicate queue entries are skipped.
+    std::unique_ptr<std::atomic<int>[]> distance(new std::atomic<int>[cells]);
+    std::unique_ptr<std::atomic<int>[]> expanded(new std::atomic<int>[cells]);
+    m_pool.runOnAll([&](int worker) {
+        int begin = static_cast<int>(static_cast<long long>(cells) * worker / workers);
+        int end = static_cast<int>(static_cast<long long>(cells) * (worker + 1) / workers);
+        for (int i = begin; i < end; ++i) {
+            distance[i].store(SearchState::kInfinity, std::memory_order_relaxed);
+            expanded[i].store(SearchState::kInfinity, std::memory_order_relaxed);
+        }
+    });
+    for (auto& buckets : m_buckets) for (auto& bucket : buckets) bucket.clear();
+
+    // Lowers neighbour's distance and queues it in the worker's own bucket.
+    auto relax = [&](int worker, CellId neighbor, int g) {
+        int old = distance[neighbor.value].load(std::memory_order_relaxed);
+        while (g < old) {
+            if (distance[neighbor.value].compare_exchange_weak(old, g, std::memory_order_relaxed)) {
+                m_buckets[worker][(g / m_delta) % ring].push_back(neighbor);
+                return;
+            }
+        }
+    };
+    auto relaxEdges = [&](int worker, CellId cell, int g, bool light) {
+        for (unsigned open_dirs = grid.getNeighborMask(cell); open_dirs; open_dirs &= open_dirs - 1) {
+            int i = bits::countTrailingZeros(open_dirs);
+            int cost = i < 4 ? 10 : 14;
+            if ((cost <= m_delta) == light) relax(worker, cell + grid.getNeighborOffset(i), g + cost);
+        }
+    };
+
+    if (!grid.isWall(source)) {
+        distance[source.value].store(0, std::memory_order_relaxed);
+        m_buckets[0][0].push_back(source);
+    }
+
+    auto isEmpty = [&](int slot) {
+        for (int w = 0; w < workers; ++w) if (!m_buckets[w][slot].empty()) return false;
+        return true;
+    };
+    for (long long current = 0;; ++current) {
+        // Find the lowest non-empty bucket.
+        int skip = 0;
+        while (skip < ring && isEmpty(static_cast<int>((current + skip) % ring))) ++skip;
+        if (skip == ring) break;
+        current += skip;
+        const int slot = static_cast<int>(current % ring);
+
+        for (auto& settled : m_settled) settled.clear();
+        while (!isEmpty(slot)) {
+            for (int w = 0; w < workers; ++w) {
+                m_frontier[w].clear();
+                m_frontier[w].swap(m_buckets[w][slot]);
+            }
+            ++m_rounds;
+            forEachCell(m_frontier, [&](int worker, CellId cell) {
+                int g = distance[cell.value].load(std::memory_order_relaxed);
+                if (expanded[cell.value].exchange(g, std::memory_order_relaxed) == g) return;
+                m_settled[worker].push_back(cell);
+                relaxEdges(worker, cell, g, true);
+            });
+        }
+
+        if (m_delta < kMaxStepCost) {
+            ++m_rounds;
+            forEachCell(m_settled, [&](int worker, CellId cell) {
+                relaxEdges(worker, cell, distance[cell.value].load(std::memory_order_relaxed), false);
+            });
+        }
+    }
+
+    std::vector<int> result(static_cast<size_t>(cells));
+    for (int i = 0; i < cells; ++i) result[i] = distance[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+void DeltaStepping::forEachCell(const std::vector<std::vector<CellId>>& lists, const std::function<void(int, CellId)>& visit) {
+    std::size_t total = 0;
+    for (const auto& list : lists) total += list.size();
+    if (total <= kChunkSize) {
+        // Not worth waking the pool; the workers are idle, so borrow worker 0's buffers.
+        for (const auto& list : lists) for (CellId cell : list) visit(0, cell);
+        return;
+    }
+    std::atomic<std::size_t> next(0);
+    m_pool.runOnAll([&](int worker) {
+        while (true) {
+            std::size_t begin = next.fetch_add(kChunkSize, std::memory_order_relaxed);
+            if (begin >= total) return;
+            std::size_t end = std::min(begin + kChunkSize, total);
+            // Map the flat range back onto the lists it spans.
+            std::size_t offset = 0;
+            for (const auto& list : lists) {
+                std::size_t lo = std::max(begin, offset), hi = std::min(end, offset + list.size());
+                for (std::size_t i = lo; i < hi; ++i) visit(worker, list[i - offset]);
+                offset += list.size();
+                if (offset >= end) break;
+            }
+        }
+    });
+}
\ No newline at end of file
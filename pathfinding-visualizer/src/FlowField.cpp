@@ -0,0 +1,106 @@
+#include "FlowField.h"
+#include "Bits.h"
+#include "Directions.h"
+#include "SearchState.h"
+#include <algorithm>
+
+void FlowField::build(const Grid& grid, const Point& goal) {
+    m_grid = &grid;
+    m_version = grid.getVersion();
+    m_goal = goal;
+    const int cells = grid.getCellCount();
+    m_distance.assign(static_cast<size_t>(cells), SearchState::kInfinity);
+    m_direction.assign(static_cast<size_t>(cells), -1);
+    m_mark.assign(static_cast<size_t>(cells), 0);
+    m_markGeneration = 0;
+    m_open.reset(cells);
+
+    CellId goal_cell = grid.index(goal);
+    if (grid.isWall(goal_cell)) return;
+    m_distance[goal_cell.value] = 0;
+    m_open.push(goal_cell, 0);
+    propagate();
+}
+
+void FlowField::onWallChanged(const Point& pos) {
+    m_version = m_grid->getVersion();
+    if (pos == m_goal) {
+        build(*m_grid, m_goal);
+        return;
+    }
+    CellId cell = m_grid->index(pos);
+
+    if (!m_grid->isWall(cell)) {
+        // Opened: the cell takes its best neighbour, then improvements spread.
+        seedFromNeighbors(cell);
+        propagate();
+        return;
+    }
+
+    // Closed: every cell whose directions led through it loses its distance.
+    if (++m_markGeneration == 0) {
+        std::fill(m_mark.begin(), m_mark.end(), 0);
+        m_markGeneration = 1;
+    }
+    m_affected.clear();
+    m_affected.push_back(cell);
+    m_mark[cell.value] = m_markGeneration;
+    for (size_t k = 0; k < m_affected.size(); ++k) {
+        CellId current = m_affected[k];
+        for (int i = 0; i < dirs::kCount; ++i) {
+            CellId child = current + m_grid->getNeighborOffset(i);
+            // The child points back at current, i.e. in the opposite direction.
+            if (m_direction[child.value] == dirs::kOpposite[i] && m_mark[child.value] != m_markGeneration) {
+                m_mark[child.value] = m_markGeneration;
+                m_affected.push_back(child);
+            }
+        }
+    }
+    for (CellId c : m_affected) {
+        m_distance[c.value] = SearchState::kInfinity;
+        m_direction[c.value] = -1;
+    }
+    for (size_t k = 1; k < m_affected.size(); ++k) seedFromNeighbors(m_affected[k]);
+    propagate();
+}
+
+Point FlowField::next(const Point& p) const {
+    int dir = m_direction[m_grid->index(p).value];
+    if (dir < 0) return p;
+    return {p.first + dirs::kDr[dir], p.second + dirs::kDc[dir]};
+}
+
+void FlowField::propagate() {
+    while (!m_open.empty()) {
+        CellId current = m_open.pop();
+        int current_g = m_distance[current.value];
+        for (unsigned open_dirs = m_grid->getNeighborMask(current); open_dirs; open_dirs &= open_dirs - 1) {
+            int i = bits::countTrailingZeros(open_dirs);
+            CellId neighbor = current + m_grid->getNeighborOffset(i);
+            int g = current_g + (i < 4 ? 10 : 14);
+            if (g < m_distance[neighbor.value]) {
+                m_distance[neighbor.value] = g;
+                m_direction[neighbor.value] = static_cast<std::int8_t>(dirs::kOpposite[i]);
+                m_open.push(neighbor, g);
+            }
+        }
+    }
+}
+
+void FlowField::seedFromNeighbors(CellId cell) {
+    int best = SearchState::kInfinity, best_dir = -1;
+    for (unsigned open_dirs = m_grid->getNeighborMask(cell); open_dirs; open_dirs &= open_dirs - 1) {
+        int i = bits::countTrailingZeros(open_dirs);
+        int d = m_distance[(cell + m_grid->getNeighborOffset(i)).value];
+        if (d == SearchState::kInfinity) continue;
+        int g = d + (i < 4 ? 10 : 14);
+        if (g < best) {
+            best = g;
+            best_dir = i;
+        }
+    }
+    if (best_dir < 0) return;
+    m_distance[cell.value] = best;
+    m_direction[cell.value] = static_cast<std::int8_t>(best_dir);
+    m_open.push(cell, best);
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "FrontierSearchPathfinder.h"
+#include "Bits.h"
+#include "Directions.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+constexpr std::uint8_t FrontierSearchPathfinder::kOpen[2];
+constexpr std::uint8_t FrontierSearchPathfinder::kClosed[2];
+
+void FrontierSearchPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    m_start = start;
+    m_end = end;
+    m_path.clear();
+    m_segments.clear();
+    m_searching = false;
+    m_done = false;
+    m_expansions = 0;
+    m_searches = 0;
+    m_peakOpen = 0;
+    m_peakRecords = 0;
+    m_peakTableBytes = 0;
+    m_peakQueueBytes = 0;
+    m_peakSegments = 0;
+    m_currentlyProcessing = {-1, -1};
+    if (m_records.empty()) m_records.resize(1024);
+
+    CellId start_cell = m_grid->index(start);
+    CellId end_cell = m_grid->index(end);
+    if (!m_grid->isReachable(start_cell, end_cell)) {
+        m_done = true;
+        return;
+    }
+    m_segments.push_back({start_cell, end_cell, -1});
+}
+
+void FrontierSearchPathfinder::onWallChanged(const Point& pos) {
+    init(*m_grid, m_start, m_end);
+}
+
+AlgoState FrontierSearchPathfinder::step() {
+    if (m_done) return m_path.empty() ? AlgoState::PathNotFound : AlgoState::PathFound;
+
+    if (!m_searching) {
+        nextSegment();
+        if (m_searching) return AlgoState::Running;
+        m_done = true;
+        m_currentlyProcessing = {-1, -1};
+        return AlgoState::PathFound;
+    }
+
+    // Once either side's smallest f reaches the best meeting, no path through
+    // its frontier can beat it: split the segment at the meeting edge.
+    int top_fwd = topKey(0);
+    int top_bwd = topKey(1);
+    if (m_meetCost == SearchState::kInfinity && top_fwd == SearchState::kInfinity && top_bwd == SearchState::kInfinity) {
+        // Only if the component labels were stale.
+        m_path.clear();
+        m_done = true;
+        return AlgoState::PathNotFound;
+    }
+    if (m_meetCost <= std::max(top_fwd, top_bwd)) {
+        m_searching = false;
+        m_segments.push_back({m_meetB, m_current.to, m_meetCostB});
+        m_segments.push_back({m_current.from, m_meetA, m_meetCostA});
+        m_peakSegments = std::max(m_peakSegments, m_segments.size());
+        return AlgoState::Running;
+    }
+
+    // Grow the smaller frontier, which keeps the meeting near the middle.
+    int side = m_openCount[0] <= m_openCount[1] ? 0 : 1;
+    if (m_openCount[side] == 0) side = 1 - side;
+    expand(side);
+    return AlgoState::Running;
+}
+
+void FrontierSearchPathfinder::nextSegment() {
+    while (!m_segments.empty()) {
+        Segment seg = m_segments.back();
+        m_segments.pop_back();
+        Point from = m_grid->toPoint(seg.from);
+        Point to = m_grid->toPoint(seg.to);
+        if (seg.from == seg.to) {
+            if (m_path.empty() || m_path.back() != from) m_path.push_back(from);
+            continue;
+        }
+        // A single move that is already known to be optimal.
+        int dr = std::abs(from.first - to.first);
+        int dc = std::abs(from.second - to.second);
+        if (seg.cost >= 0 && dr <= 1 && dc <= 1 && seg.cost == (dr && dc ? 14 : 10)) {
+            if (m_path.empty() || m_path.back() != from) m_path.push_back(from);
+            m_path.push_back(to);
+            continue;
+        }
+
+        // Start a bidirectional search for this segment.
+        m_current = seg;
+        m_searching = true;
+        ++m_searches;
+        if (++m_generation == 0) {
+            m_generation = 1;
+            for (Record& r : m_records) r.stamp = 0;
+        }
+        m_recordCount = 0;
+        m_meetCost = SearchState::kInfinity;
+        CellId ends[2] = {seg.from, seg.to};
+        for (int side = 0; side < 2; ++side) {
+            m_open[side].clear();
+            Record& r = insert(ends[side]);
+            r.g[side] = 0;
+            r.flags |= kOpen[side];
+            m_open[side].push_back(makePQElement(heuristic(ends[side], ends[1 - side]), ends[side]));
+            m_openCount[side] = 1;
+        }
+        return;
+    }
+}
+
+void FrontierSearchPathfinder::expand(int side) {
+    CellId target = side == 0 ? m_current.to : m_current.from;
+    CellId current = getCell(m_open[side].front());
+    std::pop_heap(m_open[side].begin(), m_open[side].end(), std::greater<PQElement>());
+    m_open[side].pop_back();
+
+    Record* rec = find(current);
+    int g = rec->g[side];
+    unsigned todo = m_grid->getNeighborMask(current) & ~rec->used[side];
+    rec->flags = static_cast<std::uint8_t>((rec->flags & ~kOpen[side]) | kClosed[side]);
+    --m_openCount[side];
+    ++m_expansions;
+    m_currentlyProcessing = m_grid->toPoint(current);
+
+    for (; todo; todo &= todo - 1) {
+        int i = bits::countTrailingZeros(todo);
+        CellId neighbor = current + m_grid->getNeighborOffset(i);
+        int tentative_g = g + (i < 4 ? 10 : 14);
+        Record& next = insert(neighbor);
+        // The neighbour must never generate the cell being closed.
+        next.used[side] |= static_cast<std::uint8_t>(1u << dirs::kOpposite[i]);
+        if ((next.flags & kClosed[side]) || tentative_g >= next.g[side]) continue;
+        next.g[side] = tentative_g;
+        if (!(next.flags & kOpen[side])) {
+            next.flags |= kOpen[side];
+            ++m_openCount[side];
+        }
+        m_open[side].push_back(makePQElement(tentative_g + heuristic(neighbor, target), neighbor));
+        std::push_heap(m_open[side].begin(), m_open[side].end(), std::greater<PQElement>());
+
+        int other_g = next.g[1 - side];
+        if (other_g == SearchState::kInfinity || tentative_g + other_g >= m_meetCost) continue;
+        m_meetCost = tentative_g + other_g;
+        if (side == 0) {
+            m_meetA = current;
+            m_meetCostA = g;
+            m_meetB = neighbor;
+            m_meetCostB = other_g;
+        } else {
+            m_meetA = neighbor;
+            m_meetCostA = other_g;
+            m_meetB = current;
+            m_meetCostB = g;
+        }
+    }
+
+    // A cell that has left both frontiers is forgotten; its neighbours' used
+    // directions keep it from being generated again.
+    rec = find(current);
+    if (!(rec->flags & kOpen[1 - side])) erase(current);
+
+    m_peakOpen = std::max(m_peakOpen, m_openCount[0] + m_openCount[1]);
+    m_peakRecords = std::max(m_peakRecords, m_recordCount);
+    m_peakTableBytes = std::max(m_peakTableBytes, m_records.size() * sizeof(Record));
+    m_peakQueueBytes = std::max(m_peakQueueBytes, (m_open[0].size() + m_open[1].size()) * sizeof(PQElement));
+}
+
+int FrontierSearchPathfinder::topKey(int side) {
+    CellId target = side == 0 ? m_current.to : m_current.from;
+    std::vector<PQElement>& open = m_open[side];
+    while (!open.empty()) {
+        CellId cell = getCell(open.front());
+        int key = getPriority(open.front());
+        const Record* rec = find(cell);
+        if (rec && (rec->flags & kOpen[side]) && rec->g[side] + heuristic(cell, target) == key) return key;
+        std::pop_heap(open.begin(), open.end(), std::greater<PQElement>());
+        open.pop_back();
+    }
+    return SearchState::kInfinity;
+}
+
+int FrontierSearchPathfinder::heuristic(CellId cell, CellId target) const {
+    Point p = m_grid->toPoint(cell);
+    Point t = m_grid->toPoint(target);
+    int dr = std::abs(p.first - t.first);
+    int dc = std::abs(p.second - t.second);
+    return 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+}
+
+bool FrontierSearchPathfinder::isVisitedFwd(CellId id) const {
+    const Record* rec = m_searching ? find(id) : nullptr;
+    return rec && (rec->flags & kOpen[0]);
+}
+
+bool FrontierSearchPathfinder::isVisitedBwd(CellId id) const {
+    const Record* rec = m_searching ? find(id) : nullptr;
+    return rec && (rec->flags & kOpen[1]);
+}
+
+std::size_t FrontierSearchPathfinder::getPeakMemoryBytes() const {
+    return m_peakTableBytes + m_peakQueueBytes + m_peakSegments * sizeof(Segment);
+}
+
+FrontierSearchPathfinder::Record* FrontierSearchPathfinder::find(CellId cell) {
+    std::size_t mask = m_records.size() - 1;
+    for (std::size_t i = home(cell.value);; i = (i + 1) & mask) {
+        Record& r = m_records[i];
+        if (r.stamp != m_generation) return nullptr;
+        if (r.cell == cell.value) return &r;
+    }
+}
+
+const FrontierSearchPathfinder::Record* FrontierSearchPathfinder::find(CellId cell) const {
+    return const_cast<FrontierSearchPathfinder*>(this)->find(cell);
+}
+
+FrontierSearchPathfinder::Record& FrontierSearchPathfinder::insert(CellId cell) {
+    if ((m_recordCount + 1) * 2 > m_records.size()) grow();
+    std::size_t mask = m_records.size() - 1;
+    for (std::size_t i = home(cell.value);; i = (i + 1) & mask) {
+        Record& r = m_records[i];
+        if (r.stamp != m_generation) {
+            r = Record{cell.value, m_generation, {SearchState::kInfinity, SearchState::kInfinity}, {0, 0}, 0};
+            ++m_recordCount;
+            return r;
+        }
+        if (r.cell == cell.value) return r;
+    }
+}
+
+void FrontierSearchPathfinder::erase(CellId cell) {
+    // Linear probing with backward shift: later records of the same run move
+    // up so that no lookup stops early at the hole.
+    std::size_t mask = m_records.size() - 1;
+    std::size_t hole = home(cell.value);
+    while (m_records[hole].cell != cell.value) hole = (hole + 1) & mask;
+    for (std::size_t i = (hole + 1) & mask; m_records[i].stamp == m_generation; i = (i + 1) & mask) {
+        std::size_t want = home(m_records[i].cell);
+        // Movable unless its home lies cyclically in (hole, i].
+        if (((i - want) & mask) >= ((i - hole) & mask)) {
+            m_records[hole] = m_records[i];
+            hole = i;
+        }
+    }
+    m_records[hole].stamp = 0;
+    --m_recordCount;
+}
+
+void FrontierSearchPathfinder::grow() {
+    std::vector<Record> old(m_records.size() * 2, Record{0, 0, {0, 0}, {0, 0}, 0});
+    old.swap(m_records);
+    std::uint32_t live = m_generation;
+    m_generation = 1;
+    std::size_t mask = m_records.size() - 1;
+    for (const Record& r : old) {
+        if (r.stamp != live) continue;
+        std::size_t i = home(r.cell);
+        while (m_records[i].stamp == m_generation) i = (i + 1) & mask;
+        m_records[i] = r;
+        m_records[i].stamp = m_generation;
+    }
+}
\ No newline at end of file
@@ -1,28 +1,403 @@
 #include "Grid.h"
+#include "Bits.h"
+#include "Directions.h"
 #include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
 
-Grid::Grid(int r, int c) : rows(r), cols(c) {
+constexpr std::uint32_t Grid::kNoComponent;
+constexpr std::uint32_t Grid::kFloodLabels;
+
+Grid::Grid(int r, int c) : rows(r), cols(c), stride(c + 2) {
     if (r <= 0 || c <= 0) {
         throw std::invalid_argument("Rows and cols must be positive.");
     }
-    grid_data.resize(rows, std::vector<Node>(cols));
+    for (int i = 0; i < dirs::kCount; ++i) neighbor_offsets[i] = dirs::kDr[i] * stride + dirs::kDc[i];
+
+    // Everything starts as wall (including bits past the last cell), then the
+    // logical area is opened up, leaving the sentinel ring in place.
+    grid_data.assign(static_cast<size_t>(getCellCount()), Node{true});
+    // Two spare words let getWallWord read 64 bits past any neighbour of a cell.
+    wall_bits.assign(static_cast<size_t>(getCellCount()) / 64 + 3, ~0ULL);
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) setWall(index(row, col), false);
+    }
+    rebuildNeighborMasks();
+    rebuildComponents();
+}
+
+void Grid::setWall(CellId id, bool wall) {
+    grid_data[id.value].is_wall = wall;
+    std::uint64_t bit = 1ULL << (id.value & 63);
+    if (wall) wall_bits[id.value >> 6] |= bit;
+    else wall_bits[id.value >> 6] &= ~bit;
+}
+
+std::uint64_t Grid::getWallWord(int pos) const {
+    if (pos < 0) {
+        int shift = -pos;
+        if (shift >= 64) return ~0ULL;
+        return getWallWord(0) << shift | ((1ULL << shift) - 1);
+    }
+    std::uint32_t word = static_cast<std::uint32_t>(pos) >> 6, off = pos & 63;
+    std::uint64_t v = wall_bits[word] >> off;
+    if (off) v |= wall_bits[word + 1] << (64 - off);
+    return v;
+}
+
+std::uint8_t Grid::computeNeighborMask(CellId id) const {
+    if (isWall(id)) return 0;
+    // The sentinel ring guarantees all three runs stay inside the buffer.
+    int pos = static_cast<int>(id.value);
+    std::uint64_t above = getWallWord(pos - stride - 1) & 7;
+    std::uint64_t same = getWallWord(pos - 1) & 7;
+    std::uint64_t below = getWallWord(pos + stride - 1) & 7;
+
+    std::uint64_t walls = (above >> 1 & 1)        // N
+                        | (below >> 1 & 1) << 1   // S
+                        | (same & 1) << 2         // W
+                        | (same >> 2 & 1) << 3    // E
+                        | (above & 1) << 4        // NW
+                        | (above >> 2 & 1) << 5   // NE
+                        | (below & 1) << 6        // SW
+                        | (below >> 2 & 1) << 7;  // SE
+    return static_cast<std::uint8_t>(~walls);
+}
+
+void Grid::rebuildNeighborMasks() {
+    neighbor_masks.assign(static_cast<size_t>(getCellCount()), 0);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            CellId id = index(r, c);
+            neighbor_masks[id.value] = computeNeighborMask(id);
+        }
+    }
+}
+
+std::uint32_t Grid::getComponent(CellId id) const {
+    std::uint32_t label = component_label[id.value];
+    return label == kNoComponent ? kNoComponent : findComponent(label);
 }
 
-const Node& Grid::getNode(int r, int c) const {
-    return grid_data[r][c];
+bool Grid::isReachable(CellId a, CellId b) const {
+    std::uint32_t component = getComponent(a);
+    return component != kNoComponent && component == getComponent(b);
 }
 
-Node& Grid::getNode(int r, int c) {
-    return grid_data[r][c];
+std::uint32_t Grid::newComponent() {
+    std::uint32_t label = static_cast<std::uint32_t>(component_parent.size());
+    component_parent.push_back(label);
+    component_rank.push_back(0);
+    return label;
+}
+
+std::uint32_t Grid::findComponent(std::uint32_t label) const {
+    while (component_parent[label] != label) label = component_parent[label];
+    return label;
+}
+
+std::uint32_t Grid::uniteComponents(std::uint32_t a, std::uint32_t b) {
+    a = findComponent(a);
+    b = findComponent(b);
+    if (a == b) return a;
+    if (component_rank[a] < component_rank[b]) std::swap(a, b);
+    component_parent[b] = a;
+    if (component_rank[a] == component_rank[b]) ++component_rank[a];
+    return a;
+}
+
+// One flood fill per component; also drops the labels left over by edits.
+void Grid::rebuildComponents() {
+    component_label.assign(static_cast<size_t>(getCellCount()), kNoComponent);
+    component_parent.clear();
+    component_rank.clear();
+    for (std::uint32_t i = 0; i < kFloodLabels; ++i) newComponent();
+    std::vector<CellId> stack;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            CellId seed = index(r, c);
+            if (isWall(seed) || component_label[seed.value] != kNoComponent) continue;
+            std::uint32_t label = newComponent();
+            component_label[seed.value] = label;
+            stack.push_back(seed);
+            while (!stack.empty()) {
+                CellId cell = stack.back();
+                stack.pop_back();
+                for (unsigned open_dirs = neighbor_masks[cell.value]; open_dirs; open_dirs &= open_dirs - 1) {
+                    CellId next = cell + neighbor_offsets[bits::countTrailingZeros(open_dirs)];
+                    if (component_label[next.value] != kNoComponent) continue;
+                    component_label[next.value] = label;
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+}
+
+// A new wall at `removed` can only split its component if its open
+// neighbours (ringOpen, in direction order) fall into more than one group
+// of mutually adjacent cells. If they do, each group floods outward under one
+// of the reserved flood labels, one cell per group per round. Floods that
+// meet are merged; a flood that runs out first has found a separated piece.
+// Once a single flood is left, it keeps the old label for everything it has
+// not reached, so the work is bounded by the smaller pieces. Finally every
+// flooded cell is relabelled, and only the separated pieces take new labels.
+void Grid::splitComponents(CellId removed, std::uint8_t ringOpen) {
+    int group_of[8];
+    int groups = 0;
+    for (int i = 0; i < dirs::kCount; ++i) {
+        group_of[i] = -1;
+        if (!(ringOpen >> i & 1)) continue;
+        group_of[i] = groups++;
+        for (int j = 0; j < i; ++j) {
+            if (group_of[j] < 0 || std::abs(dirs::kDr[i] - dirs::kDr[j]) > 1 || std::abs(dirs::kDc[i] - dirs::kDc[j]) > 1) continue;
+            int from = group_of[i], to = group_of[j];
+            if (from == to) continue;
+            for (int k = 0; k <= i; ++k) {
+                if (group_of[k] == from) group_of[k] = to;
+            }
+        }
+    }
+    std::vector<std::vector<CellId>> floods;
+    std::uint32_t old_root = kNoComponent;
+    for (int i = 0; i < dirs::kCount; ++i) {
+        if (group_of[i] < 0) continue;
+        bool seen = false;
+        for (int j = 0; j < i; ++j) seen = seen || group_of[j] == group_of[i];
+        if (seen) continue;
+        CellId seed = removed + neighbor_offsets[i];
+        old_root = findComponent(component_label[seed.value]);
+        floods.push_back({seed});
+    }
+    if (floods.size() <= 1) return;
+    std::uint32_t labels[8];
+    for (size_t g = 0; g < floods.size(); ++g) {
+        labels[g] = static_cast<std::uint32_t>(g);
+        component_parent[g] = labels[g];
+        component_rank[g] = 0;
+        component_label[floods[g][0].value] = labels[g];
+    }
+
+    std::vector<size_t> heads(floods.size(), 0);
+    while (true) {
+        std::uint32_t live[8];
+        int live_count = 0;
+        for (size_t g = 0; g < floods.size(); ++g) {
+            if (heads[g] == floods[g].size()) continue;
+            std::uint32_t root = findComponent(labels[g]);
+            if (std::find(live, live + live_count, root) == live + live_count) live[live_count++] = root;
+        }
+        if (live_count <= 1) {
+            // The piece still flooding (or, if all ran out together, the
+            // first one) keeps the old label; each other piece gets a new one.
+            std::uint32_t keeper = findComponent(live_count == 1 ? live[0] : labels[0]);
+            std::uint32_t final_label[8];
+            for (size_t g = 0; g < floods.size(); ++g) final_label[g] = kNoComponent;
+            for (size_t g = 0; g < floods.size(); ++g) {
+                std::uint32_t root = findComponent(labels[g]);
+                if (final_label[root] == kNoComponent) final_label[root] = root == keeper ? old_root : newComponent();
+                for (CellId cell : floods[g]) component_label[cell.value] = final_label[root];
+            }
+            return;
+        }
+        for (size_t g = 0; g < floods.size(); ++g) {
+            if (heads[g] == floods[g].size()) continue;
+            CellId cell = floods[g][heads[g]++];
+            for (unsigned open_dirs = neighbor_masks[cell.value]; open_dirs; open_dirs &= open_dirs - 1) {
+                CellId next = cell + neighbor_offsets[bits::countTrailingZeros(open_dirs)];
+                std::uint32_t root = findComponent(component_label[next.value]);
+                if (root == old_root) {
+                    component_label[next.value] = labels[g];
+                    floods[g].push_back(next);
+                } else {
+                    uniteComponents(root, labels[g]);
+                }
+            }
+        }
+    }
+}
+
+// One step of the jump distance recurrence: the entry for id follows from
+// its neighbour in direction dir, which must already be up to date (and, for
+// a diagonal, so must that neighbour's straight entries).
+int Grid::computeJumpDistance(CellId id, int dir) const {
+    if (isWall(id)) return 0;
+    CellId next = id + neighbor_offsets[dir];
+    if (isWall(next)) return 0;
+    bool jumpPoint = dirs::hasForcedNeighbor(neighbor_masks[next.value], dir);
+    if (!jumpPoint && dirs::isDiagonal(dir)) {
+        int horizontal = dirs::index(0, dirs::kDc[dir]);
+        int vertical = dirs::index(dirs::kDr[dir], 0);
+        jumpPoint = getJumpDistance(next, horizontal) > 0 || getJumpDistance(next, vertical) > 0;
+    }
+    if (jumpPoint) return 1;
+    int after = getJumpDistance(next, dir);
+    return after > 0 ? after + 1 : after - 1;
+}
+
+void Grid::buildJumpTable() {
+    jump_table.assign(static_cast<size_t>(getCellCount()) * 8, 0);
+    // Straight entries first (diagonals read them), each direction visiting
+    // cells so that the neighbour it depends on is already done.
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            jump_table[index(r, c).value * 8 + 2] = computeJumpDistance(index(r, c), 2);
+            jump_table[index(r, cols - 1 - c).value * 8 + 3] = computeJumpDistance(index(r, cols - 1 - c), 3);
+            jump_table[index(r, c).value * 8 + 0] = computeJumpDistance(index(r, c), 0);
+            jump_table[index(rows - 1 - r, c).value * 8 + 1] = computeJumpDistance(index(rows - 1 - r, c), 1);
+        }
+    }
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            for (int dir = 4; dir < 6; ++dir) jump_table[index(r, c).value * 8 + dir] = computeJumpDistance(index(r, c), dir);
+            for (int dir = 6; dir < 8; ++dir) {
+                CellId id = index(rows - 1 - r, c);
+                jump_table[id.value * 8 + dir] = computeJumpDistance(id, dir);
+            }
+        }
+    }
+}
+
+// A wall flip at `changed` alters masks in its 3x3 block only, so straight
+// entries can change only along rows r-1..r+1 and columns c-1..c+1; those
+// are recomputed outright. Diagonal entries also depend on everything further
+// along their diagonal, so each cell of those rows and columns is re-evaluated
+// and any change is walked back against the direction until it dies out.
+void Grid::repairJumpTable(CellId changed) {
+    Point p = toPoint(changed);
+    for (int r = std::max(p.first - 1, 0); r <= std::min(p.first + 1, rows - 1); ++r) {
+        for (int c = 0; c < cols; ++c) {
+            jump_table[index(r, c).value * 8 + 2] = computeJumpDistance(index(r, c), 2);
+            jump_table[index(r, cols - 1 - c).value * 8 + 3] = computeJumpDistance(index(r, cols - 1 - c), 3);
+        }
+    }
+    for (int c = std::max(p.second - 1, 0); c <= std::min(p.second + 1, cols - 1); ++c) {
+        for (int r = 0; r < rows; ++r) {
+            jump_table[index(r, c).value * 8 + 0] = computeJumpDistance(index(r, c), 0);
+            jump_table[index(rows - 1 - r, c).value * 8 + 1] = computeJumpDistance(index(rows - 1 - r, c), 1);
+        }
+    }
+
+    auto propagate = [this](CellId id, int dir) {
+        int back = neighbor_offsets[dirs::kOpposite[dir]];
+        // The cell before a seed reads the seed's mask and straight entries,
+        // so it is always re-evaluated. Walls (and the sentinel ring) never
+        // change, which ends every walk.
+        for (bool seed = true;; seed = false) {
+            std::int32_t& entry = jump_table[static_cast<size_t>(id.value) * 8 + dir];
+            int value = computeJumpDistance(id, dir);
+            if (value == entry && !seed) return;
+            entry = value;
+            id = id + back;
+        }
+    };
+    for (int dir = 4; dir < 8; ++dir) {
+        for (int r = std::max(p.first - 1, 0); r <= std::min(p.first + 1, rows - 1); ++r) {
+            for (int c = 0; c < cols; ++c) propagate(index(r, c), dir);
+        }
+        for (int c = std::max(p.second - 1, 0); c <= std::min(p.second + 1, cols - 1); ++c) {
+            for (int r = 0; r < rows; ++r) propagate(index(r, c), dir);
+        }
+    }
+}
+
+int Grid::findFirstWall(int r, int c_begin, int c_end) const {
+    if (c_begin >= c_end) return c_end;
+    int begin = static_cast<int>(index(r, c_begin).value);
+    int end = static_cast<int>(index(r, c_end).value);
+    int word = begin >> 6;
+    std::uint64_t w = wall_bits[word] & (~0ULL << (begin & 63));
+    while (true) {
+        if (w) {
+            int pos = word * 64 + bits::countTrailingZeros(w);
+            return pos < end ? c_begin + (pos - begin) : c_end;
+        }
+        if (++word * 64 >= end) return c_end;
+        w = wall_bits[word];
+    }
+}
+
+namespace {
+    // Walks the raster line a -> b as runs of cells sharing one minor
+    // coordinate (a row for shallow lines, a column for steep ones), in order
+    // from a. Major step i lies on minor step round_half_up(i * minor / major),
+    // so run k covers the steps from ceil((2k - 1) * major / (2 * minor)) on.
+    // f(first, last) returns false to stop early.
+    template <typename F>
+    bool forEachLineRun(const Point& a, const Point& b, F f) {
+        int dr = b.first - a.first;
+        int dc = b.second - a.second;
+        int sr = dr < 0 ? -1 : 1;
+        int sc = dc < 0 ? -1 : 1;
+        bool steep = std::abs(dr) > std::abs(dc);
+        int major = steep ? std::abs(dr) : std::abs(dc);
+        int minor = steep ? std::abs(dc) : std::abs(dr);
+        int begin = 0;
+        for (int k = 0; k <= minor; ++k) {
+            int end = k == minor ? major + 1
+                                 : static_cast<int>(((2LL * k + 1) * major + 2LL * minor - 1) / (2LL * minor));
+            Point first = steep ? Point{a.first + sr * begin, a.second + sc * k} : Point{a.first + sr * k, a.second + sc * begin};
+            Point last = steep ? Point{a.first + sr * (end - 1), a.second + sc * k} : Point{a.first + sr * k, a.second + sc * (end - 1)};
+            if (!f(first, last)) return false;
+            begin = end;
+        }
+        return true;
+    }
+}
+
+bool Grid::hasLineOfSight(const Point& a, const Point& b) const {
+    return forEachLineRun(a, b, [this](const Point& first, const Point& last) {
+        if (first.first == last.first) {
+            int c_end = std::max(first.second, last.second) + 1;
+            return findFirstWall(first.first, std::min(first.second, last.second), c_end) == c_end;
+        }
+        // Steep run: one cell per row.
+        for (int r = std::min(first.first, last.first); r <= std::max(first.first, last.first); ++r) {
+            if (isWall(index(r, first.second))) return false;
+        }
+        return true;
+    });
+}
+
+void Grid::appendLine(const Point& a, const Point& b, std::vector<Point>& out) const {
+    forEachLineRun(a, b, [&out](const Point& first, const Point& last) {
+        int sr = last.first > first.first ? 1 : last.first < first.first ? -1 : 0;
+        int sc = last.second > first.second ? 1 : last.second < first.second ? -1 : 0;
+        for (Point p = first;; p.first += sr, p.second += sc) {
+            out.push_back(p);
+            if (p == last) break;
+        }
+        return true;
+    });
 }
 
 bool Grid::isValid(int r, int c) const {
     return r >= 0 && r < rows && c >= 0 && c < cols;
 }
 
+void Grid::createMazeFromLayout(const std::vector<std::string>& layout) {
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (r >= (int)layout.size() || c >= (int)layout[r].size()) continue;
+            switch (layout[r][c]) {
+                case '#': setWall(index(r, c), true); break;
+                case 'S': start_pos = {r, c}; break;
+                case 'E': end_pos = {r, c}; break;
+                case '~': nodeAt(index(r, c)).weight = 5; break;
+                default: break;
+            }
+        }
+    }
+    rebuildNeighborMasks();
+    rebuildComponents();
+    if (hasJumpTable()) buildJumpTable();
+    ++version;
+}
+
 void Grid::generateMaze() {
-    for (auto& row : grid_data) std::fill(row.begin(), row.end(), Node{true});
+    // Fills the sentinel ring too; carving never leaves the logical area.
+    std::fill(grid_data.begin(), grid_data.end(), Node{true});
+    std::fill(wall_bits.begin(), wall_bits.end(), ~0ULL);
     std::random_device rd;
     std::mt19937 rng(rd());
     int start_r = (rng() % ((rows - 1) / 2)) * 2 + 1;
@@ -30,63 +405,52 @@ void Grid::generateMaze() {
     carvePath(start_r, start_c, rng);
     
     start_pos = {1, 1};
-    grid_data[1][1].is_wall = false;
+    setWall(index(start_pos), false);
     end_pos = {rows - 2, cols - 2};
-    grid_data[rows - 2][cols - 2].is_wall = false;
-}
-
-void Grid::reset() {
-    for (auto& row : grid_data) {
-        for (auto& node : row) {
-            node.g_score = std::numeric_limits<int>::max();
-            node.parent = {-1, -1};
-            node.g_score_bwd = std::numeric_limits<int>::max();
-            node.parent_bwd = {-1, -1};
-            node.visited_fwd = false;
-            node.visited_bwd = false;
-        }
-    }
+    setWall(index(end_pos), false);
+    rebuildNeighborMasks();
+    rebuildComponents();
+    if (hasJumpTable()) buildJumpTable();
+    ++version;
 }
 
 void Grid::toggleWall(const Point& pos) {
     if (pos != start_pos && pos != end_pos) {
-        grid_data[pos.first][pos.second].is_wall = !grid_data[pos.first][pos.second].is_wall;
-    }
-}
-
-void Grid::setCurrentlyProcessing(const Point& pos) {
-    currently_processing = pos;
-}
+        CellId id = index(pos);
+        bool wall = !isWall(id);
+        std::uint8_t was_open = neighbor_masks[id.value];
+        setWall(id, wall);
 
-std::vector<Point> Grid::reconstructPath(bool isBidirectional, Point meetingPoint) {
-    std::vector<Point> path;
-    if(isBidirectional) {
-        Point curr = meetingPoint;
-        while (curr.first != -1) {
-            path.push_back(curr);
-            curr = getNode(curr.first, curr.second).parent;
+        // Only the 3x3 block around the cell changes: flip the bit pointing
+        // back at it in each open neighbour, then recompute the cell itself.
+        for (int i = 0; i < dirs::kCount; ++i) {
+            CellId n = id + neighbor_offsets[i];
+            if (isWall(n)) continue;
+            std::uint8_t bit = static_cast<std::uint8_t>(1u << dirs::kOpposite[i]);
+            if (wall) neighbor_masks[n.value] &= ~bit;
+            else neighbor_masks[n.value] |= bit;
         }
-        std::reverse(path.begin(), path.end());
-        
-        curr = getNode(meetingPoint.first, meetingPoint.second).parent_bwd;
-        while (curr.first != -1) {
-            path.push_back(curr);
-            curr = getNode(curr.first, curr.second).parent_bwd;
-        }
-    } else {
-        Point curr = end_pos;
-        while (curr.first != -1) {
-            path.push_back(curr);
-            if (curr == start_pos) break;
-            curr = getNode(curr.first, curr.second).parent;
+        neighbor_masks[id.value] = computeNeighborMask(id);
+
+        if (wall) {
+            component_label[id.value] = kNoComponent;
+            splitComponents(id, was_open);
+        } else {
+            // An opened cell joins every component around it.
+            std::uint32_t label = kNoComponent;
+            for (unsigned open_dirs = neighbor_masks[id.value]; open_dirs; open_dirs &= open_dirs - 1) {
+                std::uint32_t other = findComponent(component_label[(id + neighbor_offsets[bits::countTrailingZeros(open_dirs)]).value]);
+                label = label == kNoComponent ? other : uniteComponents(label, other);
+            }
+            component_label[id.value] = label == kNoComponent ? newComponent() : label;
         }
-        std::reverse(path.begin(), path.end());
+        if (hasJumpTable()) repairJumpTable(id);
+        ++version;
     }
-    return path;
 }
 
 void Grid::carvePath(int r, int c, std::mt19937& rng) {
-    grid_data[r][c].is_wall = false;
+    setWall(index(r, c), false);
     int dr[] = {-2, 2, 0, 0};
     int dc[] = {0, 0, -2, 2};
     std::vector<int> directions = {0, 1, 2, 3};
@@ -94,8 +458,8 @@ void Grid::carvePath(int r, int c, std::mt19937& rng) {
     for (int dir : directions) {
         int next_r = r + dr[dir];
         int next_c = c + dc[dir];
-        if (isValid(next_r, next_c) && grid_data[next_r][next_c].is_wall) {
-            grid_data[r + dr[dir] / 2][c + dc[dir] / 2].is_wall = false;
+        if (isValid(next_r, next_c) && isWall(index(next_r, next_c))) {
+            setWall(index(r + dr[dir] / 2, c + dc[dir] / 2), false);
             carvePath(next_r, next_c, rng);
         }
     }
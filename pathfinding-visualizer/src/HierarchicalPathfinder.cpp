@@ -0,0 +1,646 @@
+#include "HierarchicalPathfinder.h"
+#include "Bits.h"
+#include "Directions.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int kInfinity = SearchState::kInfinity;
+    // Straight runs shorter than this get one transition in the middle,
+    // longer ones one at each end.
+    const int kLongEntrance = 6;
+
+    // Top-level costs run a few percent over the octile distance, since
+    // paths bend through entrances. An exact bound therefore leaves a band
+    // of nearly tied nodes that widens with the distance; inflating it by
+    // this much (in percent) keeps the search close to the final path.
+    const int kTopWeight = 108;
+
+    inline int stepCost(int dir) { return dir < 4 ? 10 : 14; }
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(int clusterSize, int superSize)
+    : m_clusterSize(clusterSize), m_superSize(superSize) {
+    m_name = "HPA* (" + std::to_string(clusterSize) + "x" + std::to_string(clusterSize) + " clusters)";
+}
+
+std::string HierarchicalPathfinder::getName() const { return m_name; }
+
+std::size_t HierarchicalPathfinder::getAbstractNodeCount() const {
+    std::size_t count = 0;
+    for (const Cluster& cluster : m_clusters) count += cluster.entrances.size();
+    return count;
+}
+
+std::size_t HierarchicalPathfinder::getSuperNodeCount() const {
+    std::size_t count = 0;
+    for (const SuperCluster& super : m_supers) count += super.entrances.size();
+    return count;
+}
+
+void HierarchicalPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    if (m_builtFor != &grid || m_builtVersion != grid.getVersion()) buildAbstraction();
+    m_start = start;
+    m_end = end;
+    startQuery();
+}
+
+void HierarchicalPathfinder::onWallChanged(const Point& pos) {
+    if (m_builtFor == m_grid && m_builtVersion + 1 == m_grid->getVersion()) {
+        // Entrances depend on the cells on both sides of a border, so every
+        // cluster touching the 3x3 block around the edit is rebuilt.
+        std::vector<int> touched;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                Point p = {pos.first + dr, pos.second + dc};
+                if (!m_grid->isValid(p.first, p.second)) continue;
+                int id = clusterOf(p);
+                if (std::find(touched.begin(), touched.end(), id) == touched.end()) touched.push_back(id);
+            }
+        }
+        // A super-cluster only has to be redone when one of its clusters
+        // came out different. Its distance rows are then left for the
+        // searches that need them, which keeps an edit cheap.
+        std::vector<int> supers;
+        for (int id : touched) {
+            Cluster before = m_clusters[id];
+            buildCluster(id);
+            const Cluster& after = m_clusters[id];
+            bool same = before.entrances == after.entrances && before.distances == after.distances &&
+                        std::equal(before.crossings.begin(), before.crossings.end(), after.crossings.begin(),
+                                   [](const std::vector<Crossing>& a, const std::vector<Crossing>& b) {
+                                       return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Crossing& x, const Crossing& y) {
+                                           return x.cell == y.cell && x.cost == y.cost;
+                                       });
+                                   });
+            int super = superOf(id);
+            if (!same && std::find(supers.begin(), supers.end(), super) == supers.end()) supers.push_back(super);
+        }
+        for (int id : supers) buildSuperCluster(id, false);
+        if (!supers.empty()) numberTopNodes();
+        m_builtVersion = m_grid->getVersion();
+    } else if (m_builtFor != m_grid || m_builtVersion != m_grid->getVersion()) {
+        buildAbstraction();
+    }
+    startQuery();
+}
+
+void HierarchicalPathfinder::buildAbstraction() {
+    m_clusterRows = (m_grid->getRows() + m_clusterSize - 1) / m_clusterSize;
+    m_clusterCols = (m_grid->getCols() + m_clusterSize - 1) / m_clusterSize;
+    m_clusters.assign(static_cast<size_t>(m_clusterRows) * m_clusterCols, Cluster());
+    m_entranceSlot.assign(m_grid->getCellCount(), -1);
+    for (int i = 0; i < m_clusterRows; ++i) {
+        for (int j = 0; j < m_clusterCols; ++j) {
+            Cluster& cluster = m_clusters[i * m_clusterCols + j];
+            cluster.row0 = i * m_clusterSize;
+            cluster.col0 = j * m_clusterSize;
+            cluster.rows = std::min(m_clusterSize, m_grid->getRows() - cluster.row0);
+            cluster.cols = std::min(m_clusterSize, m_grid->getCols() - cluster.col0);
+        }
+    }
+    for (int id = 0; id < static_cast<int>(m_clusters.size()); ++id) buildCluster(id);
+
+    m_superRows = (m_clusterRows + m_superSize - 1) / m_superSize;
+    m_superCols = (m_clusterCols + m_superSize - 1) / m_superSize;
+    m_supers.assign(static_cast<size_t>(m_superRows) * m_superCols, SuperCluster());
+    m_topId.assign(m_grid->getCellCount(), -1);
+    for (int i = 0; i < m_superRows; ++i) {
+        for (int j = 0; j < m_superCols; ++j) {
+            SuperCluster& super = m_supers[i * m_superCols + j];
+            super.clusterRow0 = i * m_superSize;
+            super.clusterCol0 = j * m_superSize;
+            super.clusterRows = std::min(m_superSize, m_clusterRows - super.clusterRow0);
+            super.clusterCols = std::min(m_superSize, m_clusterCols - super.clusterCol0);
+        }
+    }
+    for (int id = 0; id < static_cast<int>(m_supers.size()); ++id) buildSuperCluster(id, true);
+    numberTopNodes();
+    m_builtFor = m_grid;
+    m_builtVersion = m_grid->getVersion();
+}
+
+// Recomputes one cluster's entrances and the costs between them. The rules
+// only look at the border cells on both sides, so the two clusters sharing
+// a border always agree on its transitions without coordinating.
+void HierarchicalPathfinder::buildCluster(int id) {
+    Cluster& cluster = m_clusters[id];
+    for (CellId e : cluster.entrances) m_entranceSlot[e.value] = -1;
+    cluster.entrances.clear();
+    cluster.crossings.clear();
+
+    const int last_row = cluster.row0 + cluster.rows - 1;
+    const int last_col = cluster.col0 + cluster.cols - 1;
+    addStraightEntrances(cluster, {cluster.row0, cluster.col0}, 3, 0, cluster.cols); // north side
+    addStraightEntrances(cluster, {last_row, cluster.col0}, 3, 1, cluster.cols);     // south side
+    addStraightEntrances(cluster, {cluster.row0, cluster.col0}, 1, 2, cluster.rows); // west side
+    addStraightEntrances(cluster, {cluster.row0, last_col}, 1, 3, cluster.rows);     // east side
+
+    // A diagonal step whose two corner cells are both walls cannot be
+    // replaced by two straight crossings, so it gets a transition of its own.
+    for (int r = cluster.row0; r <= last_row; ++r) {
+        for (int c = cluster.col0; c <= last_col; ++c) {
+            if (r != cluster.row0 && r != last_row && c != cluster.col0 && c != last_col) continue;
+            CellId cell = m_grid->index(r, c);
+            std::uint8_t open = m_grid->getNeighborMask(cell);
+            for (int dir = 4; dir < 8; ++dir) {
+                int dr = dirs::kDr[dir], dc = dirs::kDc[dir];
+                if (!(open & (1u << dir)) || (open & dirs::bit(dr, 0)) || (open & dirs::bit(0, dc))) continue;
+                if (clusterOf({r + dr, c + dc}) == id) continue;
+                addEntrance(cluster, cell, cell + m_grid->getNeighborOffset(dir), stepCost(dir));
+            }
+        }
+    }
+
+    // Costs are symmetric, so the search from entrance i only has to reach
+    // the entrances after it and can stop once they are all settled.
+    size_t n = cluster.entrances.size();
+    cluster.distances.assign(n * n, kInfinity);
+    std::vector<int> targets;
+    for (size_t i = 0; i < n; ++i) {
+        targets.clear();
+        for (size_t j = i + 1; j < n; ++j) targets.push_back(localIndex(cluster, m_grid->toPoint(cluster.entrances[j])));
+        searchCluster(cluster, cluster.entrances[i], false, &targets);
+        cluster.distances[i * n + i] = 0;
+        for (size_t j = i + 1; j < n; ++j) {
+            int cost = m_localDist[targets[j - i - 1]];
+            cluster.distances[i * n + j] = cost;
+            cluster.distances[j * n + i] = cost;
+        }
+    }
+}
+
+// Collects the member clusters' entrances as nodes, keeps those with a
+// crossing out of the block as the super-cluster's entrances and finds the
+// costs between them over the first-level graph inside the block.
+void HierarchicalPathfinder::buildSuperCluster(int id, bool fillRows) {
+    SuperCluster& super = m_supers[id];
+    for (CellId e : super.entrances) m_topId[e.value] = -1;
+    super.nodes.clear();
+    super.firstNode.clear();
+    super.firstEdge.clear();
+    super.edges.clear();
+    super.entrances.clear();
+    for (int i = super.clusterRow0; i < super.clusterRow0 + super.clusterRows; ++i) {
+        for (int j = super.clusterCol0; j < super.clusterCol0 + super.clusterCols; ++j) {
+            const Cluster& cluster = m_clusters[i * m_clusterCols + j];
+            super.firstNode.push_back(static_cast<int>(super.nodes.size()));
+            for (size_t slot = 0; slot < cluster.entrances.size(); ++slot) {
+                CellId e = cluster.entrances[slot];
+                super.nodes.push_back(e);
+                for (const Crossing& crossing : cluster.crossings[slot]) {
+                    if (superOf(clusterOf(m_grid->toPoint(crossing.cell))) == id) continue;
+                    super.entrances.push_back(e);
+                    break;
+                }
+            }
+        }
+    }
+
+    for (CellId e : super.nodes) {
+        const Cluster& cluster = m_clusters[clusterOf(m_grid->toPoint(e))];
+        int slot = entranceSlot(e);
+        int first = nodeIndex(super, e) - slot; // the cluster's nodes are consecutive
+        size_t count = cluster.entrances.size();
+        super.firstEdge.push_back(static_cast<int>(super.edges.size()));
+        for (size_t j = 0; j < count; ++j) {
+            int cost = cluster.distances[slot * count + j];
+            if (cost != kInfinity && static_cast<int>(j) != slot) super.edges.push_back({first + static_cast<int>(j), cost});
+        }
+        for (const Crossing& crossing : cluster.crossings[slot]) {
+            if (superOf(clusterOf(m_grid->toPoint(crossing.cell))) == id) super.edges.push_back({nodeIndex(super, crossing.cell), crossing.cost});
+        }
+    }
+    super.firstEdge.push_back(static_cast<int>(super.edges.size()));
+
+    size_t n = super.entrances.size();
+    super.distances.assign(n * n, kInfinity);
+    super.rowReady.assign(n, fillRows);
+    if (!fillRows) return;
+
+    // Symmetric, as in buildCluster().
+    std::vector<int> targets;
+    for (size_t i = 0; i < n; ++i) {
+        targets.clear();
+        for (size_t j = i + 1; j < n; ++j) targets.push_back(nodeIndex(super, super.entrances[j]));
+        searchSuperCluster(id, {{nodeIndex(super, super.entrances[i]), 0}}, &targets);
+        super.distances[i * n + i] = 0;
+        for (size_t j = i + 1; j < n; ++j) {
+            int cost = m_superDist[targets[j - i - 1]];
+            super.distances[i * n + j] = cost;
+            super.distances[j * n + i] = cost;
+        }
+    }
+}
+
+const int* HierarchicalPathfinder::distanceRow(int id, int slot) {
+    SuperCluster& super = m_supers[id];
+    size_t n = super.entrances.size();
+    int* row = &super.distances[slot * n];
+    if (super.rowReady[slot]) return row;
+    std::vector<int> targets;
+    for (CellId e : super.entrances) targets.push_back(nodeIndex(super, e));
+    searchSuperCluster(id, {{targets[slot], 0}}, &targets);
+    for (size_t j = 0; j < n; ++j) row[j] = m_superDist[targets[j]];
+    super.rowReady[slot] = 1;
+    return row;
+}
+
+void HierarchicalPathfinder::numberTopNodes() {
+    m_superBase.assign(m_supers.size() + 1, 0);
+    m_topCells.clear();
+    for (size_t id = 0; id < m_supers.size(); ++id) {
+        m_superBase[id] = static_cast<int>(m_topCells.size());
+        for (CellId e : m_supers[id].entrances) {
+            m_topId[e.value] = static_cast<int>(m_topCells.size());
+            m_topCells.push_back(e);
+        }
+    }
+    m_superBase.back() = static_cast<int>(m_topCells.size());
+    m_startId = static_cast<int>(m_topCells.size());
+    m_goalId = m_startId + 1;
+    m_topCells.resize(m_goalId + 1);
+    m_topStamp.resize(m_goalId + 1, 0);
+    m_topG.resize(m_goalId + 1);
+    m_topParent.resize(m_goalId + 1);
+    m_topClosed.resize(m_goalId + 1);
+}
+
+// Scans `length` cells of one side, starting at `first` and moving in
+// alongDir, for runs where the cell beyond the border (in outDir) is open too.
+void HierarchicalPathfinder::addStraightEntrances(Cluster& cluster, Point first, int alongDir, int outDir, int length) {
+    CellId cell = m_grid->index(first);
+    int along = m_grid->getNeighborOffset(alongDir);
+    int out = m_grid->getNeighborOffset(outDir);
+    // Outside the map the sentinel ring reads as wall, so no run starts there.
+    int run = 0;
+    for (int k = 0; k <= length; ++k, cell = cell + along) {
+        if (k < length && (m_grid->getNeighborMask(cell) >> outDir & 1)) {
+            ++run;
+            continue;
+        }
+        if (run == 0) continue;
+        int start = k - run;
+        if (run < kLongEntrance) {
+            CellId mid = m_grid->index(first) + (start + (run - 1) / 2) * along;
+            addEntrance(cluster, mid, mid + out, 10);
+        } else {
+            CellId a = m_grid->index(first) + start * along;
+            CellId b = m_grid->index(first) + (k - 1) * along;
+            addEntrance(cluster, a, a + out, 10);
+            addEntrance(cluster, b, b + out, 10);
+        }
+        run = 0;
+    }
+}
+
+void HierarchicalPathfinder::addEntrance(Cluster& cluster, CellId inside, CellId outside, int cost) {
+    int slot = entranceSlot(inside);
+    if (slot < 0) {
+        slot = static_cast<int>(cluster.entrances.size());
+        m_entranceSlot[inside.value] = slot;
+        cluster.entrances.push_back(inside);
+        cluster.crossings.emplace_back();
+    }
+    cluster.crossings[slot].push_back({outside, cost});
+}
+
+int HierarchicalPathfinder::clusterOf(const Point& p) const {
+    return (p.first / m_clusterSize) * m_clusterCols + p.second / m_clusterSize;
+}
+
+int HierarchicalPathfinder::localIndex(const Cluster& cluster, const Point& p) const {
+    return (p.first - cluster.row0) * cluster.cols + (p.second - cluster.col0);
+}
+
+int HierarchicalPathfinder::superOf(int clusterId) const {
+    return (clusterId / m_clusterCols / m_superSize) * m_superCols + clusterId % m_clusterCols / m_superSize;
+}
+
+int HierarchicalPathfinder::nodeIndex(const SuperCluster& super, CellId cell) const {
+    int id = clusterOf(m_grid->toPoint(cell));
+    int member = (id / m_clusterCols - super.clusterRow0) * super.clusterCols + (id % m_clusterCols - super.clusterCol0);
+    return super.firstNode[member] + entranceSlot(cell);
+}
+
+std::vector<std::pair<int, int>> HierarchicalPathfinder::seedsFrom(int clusterId, const std::vector<int>& costs) const {
+    const Cluster& cluster = m_clusters[clusterId];
+    const SuperCluster& super = m_supers[superOf(clusterId)];
+    std::vector<std::pair<int, int>> seeds;
+    for (size_t j = 0; j < cluster.entrances.size(); ++j) {
+        if (costs[j] != kInfinity) seeds.push_back({nodeIndex(super, cluster.entrances[j]), costs[j]});
+    }
+    return seeds;
+}
+
+// Dijkstra over the first-level graph of one super-cluster. Distances land
+// in m_superDist and predecessors in m_superParent; given targets (nodes), it
+// stops once all are settled. With a cell to head toward it runs as A*: no
+// edge is shorter than the octile distance it spans, so settled nodes still
+// carry exact distances.
+void HierarchicalPathfinder::searchSuperCluster(int id, const std::vector<std::pair<int, int>>& seeds,
+                                                const std::vector<int>* targets, CellId toward) const {
+    const SuperCluster& super = m_supers[id];
+    size_t size = super.nodes.size();
+    m_superDist.assign(size, kInfinity);
+    m_superParent.assign(size, -1);
+    int targets_left = 0;
+    if (targets) {
+        m_superIsTarget.assign(size, 0);
+        for (int t : *targets) {
+            targets_left += !m_superIsTarget[t];
+            m_superIsTarget[t] = 1;
+        }
+        if (targets_left == 0) return;
+    }
+
+    Point goal = toward.isValid() ? m_grid->toPoint(toward) : Point();
+    auto estimate = [&](int node) { return toward.isValid() ? heuristic(m_grid->toPoint(super.nodes[node]), goal) : 0; };
+    m_superOpen.clear();
+    auto relax = [&](int node, int parent, int cost) {
+        if (cost >= m_superDist[node]) return;
+        m_superDist[node] = cost;
+        m_superParent[node] = parent;
+        m_superOpen.push_back(makePQElement(cost + estimate(node), CellId(static_cast<std::uint32_t>(node))));
+        std::push_heap(m_superOpen.begin(), m_superOpen.end(), std::greater<PQElement>());
+    };
+    for (const auto& seed : seeds) relax(seed.first, -1, seed.second);
+    while (!m_superOpen.empty()) {
+        int node = static_cast<int>(getCell(m_superOpen.front()).value);
+        int d = getPriority(m_superOpen.front()) - estimate(node);
+        std::pop_heap(m_superOpen.begin(), m_superOpen.end(), std::greater<PQElement>());
+        m_superOpen.pop_back();
+        if (d != m_superDist[node]) continue;
+        if (targets && m_superIsTarget[node] && --targets_left == 0) return;
+        for (int k = super.firstEdge[node]; k < super.firstEdge[node + 1]; ++k) {
+            relax(super.edges[k].node, node, d + super.edges[k].cost);
+        }
+    }
+}
+
+int HierarchicalPathfinder::bestGoalNode(int& cost) const {
+    const Cluster& end_cluster = m_clusters[m_endCluster];
+    const SuperCluster& super = m_supers[m_endSuper];
+    int best = -1;
+    cost = kInfinity;
+    for (size_t j = 0; j < end_cluster.entrances.size(); ++j) {
+        int node = nodeIndex(super, end_cluster.entrances[j]);
+        if (m_superDist[node] == kInfinity || m_goalCosts[j] == kInfinity) continue;
+        if (m_superDist[node] + m_goalCosts[j] < cost) {
+            cost = m_superDist[node] + m_goalCosts[j];
+            best = node;
+        }
+    }
+    return best;
+}
+
+// Dijkstra from source that never leaves the cluster. Distances land in
+// m_localDist and, with keepParents, predecessors in m_localParent. Given
+// targets (local indices), it stops once all of them are settled. Steps
+// cost 10 or 14, so pending distances always fit a ring of 15 buckets.
+void HierarchicalPathfinder::searchCluster(const Cluster& cluster, CellId source, bool keepParents,
+                                           const std::vector<int>* targets) const {
+    int size = cluster.rows * cluster.cols;
+    m_localDist.assign(size, kInfinity);
+    if (keepParents) m_localParent.assign(size, -1);
+    int targets_left = 0;
+    if (targets) {
+        m_localIsTarget.assign(size, 0);
+        for (int t : *targets) {
+            targets_left += !m_localIsTarget[t];
+            m_localIsTarget[t] = 1;
+        }
+        if (targets_left == 0) return;
+    }
+
+    Point s = m_grid->toPoint(source);
+    int first = localIndex(cluster, s);
+    m_localDist[first] = 0;
+    m_localBuckets[0].push_back(first);
+    int pending = 1;
+    for (int d = 0; pending > 0; ++d) {
+        std::vector<int>& bucket = m_localBuckets[d % kLocalBuckets];
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            int local = bucket[i];
+            --pending;
+            if (m_localDist[local] != d) continue;
+            if (targets && m_localIsTarget[local] && --targets_left == 0) {
+                for (std::vector<int>& b : m_localBuckets) b.clear();
+                return;
+            }
+            int lr = local / cluster.cols, lc = local % cluster.cols;
+            // Drop the moves that would leave the cluster.
+            unsigned open_dirs = m_grid->getNeighborMask(m_grid->index(cluster.row0 + lr, cluster.col0 + lc));
+            if (lr == 0) open_dirs &= ~(dirs::bit(-1, -1) | dirs::bit(-1, 0) | dirs::bit(-1, 1));
+            if (lr == cluster.rows - 1) open_dirs &= ~(dirs::bit(1, -1) | dirs::bit(1, 0) | dirs::bit(1, 1));
+            if (lc == 0) open_dirs &= ~(dirs::bit(-1, -1) | dirs::bit(0, -1) | dirs::bit(1, -1));
+            if (lc == cluster.cols - 1) open_dirs &= ~(dirs::bit(-1, 1) | dirs::bit(0, 1) | dirs::bit(1, 1));
+            for (; open_dirs; open_dirs &= open_dirs - 1) {
+                int dir = bits::countTrailingZeros(open_dirs);
+                int next = local + dirs::kDr[dir] * cluster.cols + dirs::kDc[dir];
+                int cost = d + stepCost(dir);
+                if (cost < m_localDist[next]) {
+                    m_localDist[next] = cost;
+                    if (keepParents) m_localParent[next] = local;
+                    m_localBuckets[cost % kLocalBuckets].push_back(next);
+                    ++pending;
+                }
+            }
+        }
+        bucket.clear();
+    }
+}
+
+// Connects start and goal to the entrances of their clusters, then seeds the
+// abstract search.
+void HierarchicalPathfinder::startQuery() {
+    m_state.resize(m_grid->getCellCount());
+    m_state.reset();
+    m_open.reset(m_goalId + 1);
+    m_peakOpen = 0;
+    m_path.clear();
+    m_startCell = m_grid->index(m_start);
+    m_endCell = m_grid->index(m_end);
+    m_startCluster = clusterOf(m_start);
+    m_endCluster = clusterOf(m_end);
+
+    const Cluster& end_cluster = m_clusters[m_endCluster];
+    searchCluster(end_cluster, m_endCell, false);
+    m_goalCosts.clear();
+    for (CellId e : end_cluster.entrances) m_goalCosts.push_back(m_localDist[localIndex(end_cluster, m_grid->toPoint(e))]);
+
+    const Cluster& start_cluster = m_clusters[m_startCluster];
+    searchCluster(start_cluster, m_startCell, false);
+    m_startCosts.clear();
+    for (CellId e : start_cluster.entrances) m_startCosts.push_back(m_localDist[localIndex(start_cluster, m_grid->toPoint(e))]);
+    m_directCost = m_startCluster == m_endCluster ? m_localDist[localIndex(start_cluster, m_end)] : kInfinity;
+
+    // The same one level up, over the first-level graph of each block.
+    m_startSuper = superOf(m_startCluster);
+    m_endSuper = superOf(m_endCluster);
+    searchSuperCluster(m_endSuper, seedsFrom(m_endCluster, m_goalCosts));
+    m_superGoalCosts.clear();
+    for (CellId e : m_supers[m_endSuper].entrances) m_superGoalCosts.push_back(m_superDist[nodeIndex(m_supers[m_endSuper], e)]);
+
+    searchSuperCluster(m_startSuper, seedsFrom(m_startCluster, m_startCosts));
+    m_superStartCosts.clear();
+    for (CellId e : m_supers[m_startSuper].entrances) m_superStartCosts.push_back(m_superDist[nodeIndex(m_supers[m_startSuper], e)]);
+    m_superDirectCost = kInfinity;
+    if (m_startSuper == m_endSuper) bestGoalNode(m_superDirectCost);
+    m_superDirectCost = std::min(m_superDirectCost, m_directCost);
+
+    m_topCells[m_startId] = m_startCell;
+    m_topCells[m_goalId] = m_endCell;
+    if (++m_topGeneration == 0) {
+        std::fill(m_topStamp.begin(), m_topStamp.end(), 0);
+        m_topGeneration = 1;
+    }
+    m_topStamp[m_startId] = m_topGeneration;
+    m_topG[m_startId] = 0;
+    m_topParent[m_startId] = -1;
+    m_topClosed[m_startId] = 0;
+    m_open.push(CellId(static_cast<std::uint32_t>(m_startId)), calculateKey(m_startId, 0));
+    m_peakOpen = 1;
+}
+
+AlgoState HierarchicalPathfinder::step() {
+    if (m_open.empty()) {
+        m_currentlyProcessing = {-1, -1};
+        return AlgoState::PathNotFound;
+    }
+
+    // The heap decreases keys in place, so every pop is a fresh node.
+    int current = static_cast<int>(m_open.top().cell.value);
+    m_open.pop();
+    m_topClosed[current] = 1;
+    CellId current_cell = m_topCells[current];
+    m_state.setVisitedFwd(current_cell);
+    Point current_pos = m_grid->toPoint(current_cell);
+    m_currentlyProcessing = current_pos;
+
+    if (current == m_goalId) {
+        refinePath();
+        m_currentlyProcessing = {-1, -1};
+        return AlgoState::PathFound;
+    }
+
+    int current_g = m_topG[current];
+    auto relax = [&](int next, int cost) {
+        if (cost == kInfinity) return;
+        if (m_topStamp[next] != m_topGeneration) {
+            m_topStamp[next] = m_topGeneration;
+            m_topG[next] = kInfinity;
+            m_topClosed[next] = 0;
+        }
+        int tentative_g_score = current_g + cost;
+        if (m_topClosed[next] || tentative_g_score >= m_topG[next]) return;
+        m_topParent[next] = current;
+        m_topG[next] = tentative_g_score;
+        m_open.push(CellId(static_cast<std::uint32_t>(next)), calculateKey(next, tentative_g_score));
+    };
+
+    if (current == m_startId) {
+        int base = m_superBase[m_startSuper];
+        for (size_t j = 0; j < m_superStartCosts.size(); ++j) relax(base + static_cast<int>(j), m_superStartCosts[j]);
+        relax(m_goalId, m_superDirectCost);
+    } else {
+        int cluster_id = clusterOf(current_pos);
+        int id = superOf(cluster_id);
+        const SuperCluster& super = m_supers[id];
+        int base = m_superBase[id];
+        int slot = current - base;
+        const int* row = distanceRow(id, slot);
+        for (size_t j = 0; j < super.entrances.size(); ++j) relax(base + static_cast<int>(j), row[j]);
+        for (const Crossing& crossing : m_clusters[cluster_id].crossings[entranceSlot(current_cell)]) {
+            if (superOf(clusterOf(m_grid->toPoint(crossing.cell))) != id) relax(m_topId[crossing.cell.value], crossing.cost);
+        }
+        if (id == m_endSuper) relax(m_goalId, m_superGoalCosts[slot]);
+    }
+    m_peakOpen = std::max(m_peakOpen, m_open.size());
+    return AlgoState::Running;
+}
+
+void HierarchicalPathfinder::appendRoute(CellId from, CellId to, std::vector<CellId>& route) const {
+    int id = superOf(clusterOf(m_grid->toPoint(from)));
+    const SuperCluster& super = m_supers[id];
+    bool from_start = from == m_startCell;
+    // The search can stop at the entrances the edge may end on.
+    std::vector<int> targets;
+    if (to == m_endCell) {
+        for (CellId e : m_clusters[m_endCluster].entrances) targets.push_back(nodeIndex(super, e));
+    } else {
+        targets.push_back(nodeIndex(super, to));
+    }
+    if (from_start) {
+        searchSuperCluster(id, seedsFrom(m_startCluster, m_startCosts), &targets, to);
+    } else {
+        searchSuperCluster(id, {{nodeIndex(super, from), 0}}, &targets, to);
+    }
+
+    int last;
+    if (to == m_endCell) {
+        int cost;
+        last = bestGoalNode(cost);
+        if (from_start && m_directCost <= cost) last = -1;
+    } else {
+        last = nodeIndex(super, to);
+    }
+    std::vector<CellId> nodes;
+    for (int node = last; node >= 0; node = m_superParent[node]) nodes.push_back(super.nodes[node]);
+    if (!from_start && !nodes.empty()) nodes.pop_back(); // from itself
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        if (route.back() != *it) route.push_back(*it);
+    }
+    if (route.back() != to) route.push_back(to);
+}
+
+// Replaces every top-level edge by first-level entrances, then every
+// first-level edge by cells. At both levels crossings are single steps and
+// all other edges stay inside one block, where they are re-searched.
+void HierarchicalPathfinder::refinePath() {
+    std::vector<Point> abstract_path;
+    for (int id = m_goalId; id >= 0; id = m_topParent[id]) abstract_path.push_back(m_grid->toPoint(m_topCells[id]));
+    std::reverse(abstract_path.begin(), abstract_path.end());
+    std::vector<CellId> route = {m_grid->index(abstract_path.front())};
+    for (size_t i = 1; i < abstract_path.size(); ++i) {
+        CellId from = m_grid->index(abstract_path[i - 1]), to = m_grid->index(abstract_path[i]);
+        if (superOf(clusterOf(abstract_path[i - 1])) != superOf(clusterOf(abstract_path[i]))) {
+            route.push_back(to);
+        } else {
+            appendRoute(from, to, route);
+        }
+    }
+
+    m_path.clear();
+    m_path.push_back(m_grid->toPoint(route.front()));
+    for (size_t i = 1; i < route.size(); ++i) {
+        Point from = m_grid->toPoint(route[i - 1]), to = m_grid->toPoint(route[i]);
+        int id = clusterOf(from);
+        if (id != clusterOf(to)) {
+            m_path.push_back(to);
+            continue;
+        }
+        const Cluster& cluster = m_clusters[id];
+        std::vector<int> target = {localIndex(cluster, to)};
+        searchCluster(cluster, route[i - 1], true, &target);
+        std::vector<Point> segment;
+        for (int l = localIndex(cluster, to); l != localIndex(cluster, from); l = m_localParent[l]) {
+            segment.push_back({cluster.row0 + l / cluster.cols, cluster.col0 + l % cluster.cols});
+        }
+        m_path.insert(m_path.end(), segment.rbegin(), segment.rend());
+    }
+}
+
+int HierarchicalPathfinder::heuristic(const Point& a, const Point& b) const {
+    // Octile distance
+    int dr = std::abs(a.first - b.first);
+    int dc = std::abs(a.second - b.second);
+    return 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+}
+
+std::uint64_t HierarchicalPathfinder::calculateKey(int id, int g) const {
+    int h = heuristic(m_grid->toPoint(m_topCells[id]), m_end) * kTopWeight / 100;
+    std::uint64_t f = static_cast<std::uint64_t>(g) + static_cast<std::uint64_t>(h);
+    return f << 32 | (0xFFFFFFFFu - static_cast<std::uint32_t>(g));
+}
\ No newline at end of file
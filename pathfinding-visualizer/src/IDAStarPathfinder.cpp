@@ -0,0 +1,188 @@
+#include "IDAStarPathfinder.h"
+#include "Bits.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+constexpr int IDAStarPathfinder::kWays;
+
+IDAStarPathfinder::IDAStarPathfinder(std::size_t memoryBytes) : m_memoryBytes(memoryBytes) {
+    // Power-of-two bucket count, so the table never exceeds memoryBytes.
+    std::size_t buckets = 1;
+    while (buckets * 2 * kWays * sizeof(Entry) <= memoryBytes) buckets *= 2;
+    m_bucketMask = buckets - 1;
+}
+
+std::string IDAStarPathfinder::getName() const {
+    std::ostringstream name;
+    name << "IDA* (" << (m_bucketMask + 1) * kWays * sizeof(Entry) / 1024 << " KiB table)";
+    return name.str();
+}
+
+void IDAStarPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    m_start = start;
+    m_end = end;
+    m_startCell = m_grid->index(start);
+    m_endCell = m_grid->index(end);
+    m_path.clear();
+    m_table.assign((m_bucketMask + 1) * kWays, Entry{0, 0, 0, 0});
+    m_stack.clear();
+    m_peakDepth = 0;
+    m_pass = 0;
+    m_expansions = 0;
+    m_done = false;
+    m_currentlyProcessing = {-1, -1};
+
+    if (!m_grid->isReachable(m_startCell, m_endCell)) {
+        m_done = true;
+        return;
+    }
+    if (m_startCell == m_endCell) {
+        m_path.push_back(start);
+        m_done = true;
+        return;
+    }
+    m_nextThreshold = heuristic(m_startCell);
+}
+
+void IDAStarPathfinder::onWallChanged(const Point& pos) {
+    init(*m_grid, m_start, m_end);
+}
+
+AlgoState IDAStarPathfinder::step() {
+    if (m_done) return m_path.empty() ? AlgoState::PathNotFound : AlgoState::PathFound;
+
+    for (;;) {
+        if (m_stack.empty()) {
+            // Next pass: the threshold rises to the smallest f the last one
+            // cut off, or to the start's learned h if that is larger.
+            m_threshold = std::max(m_nextThreshold, lookupH(m_startCell));
+            m_nextThreshold = std::numeric_limits<int>::max();
+            ++m_pass;
+            enter(m_startCell, 0);
+            return AlgoState::Running;
+        }
+
+        Frame& top = m_stack.back();
+        if (top.next == top.count) {
+            leave();
+            continue;
+        }
+        int dir = top.dirs[top.next++];
+        CellId neighbor = top.cell + m_grid->getNeighborOffset(dir);
+        int g = top.g + (dir < 4 ? 10 : 14);
+
+        if (neighbor == m_endCell) {
+            // Everything within the threshold was tried before it rose to
+            // this f, so the first path found is optimal.
+            for (const Frame& frame : m_stack) m_path.push_back(m_grid->toPoint(frame.cell));
+            m_path.push_back(m_end);
+            m_done = true;
+            return AlgoState::PathFound;
+        }
+        if (checkAndRecord(neighbor, g)) continue;
+        enter(neighbor, g);
+        return AlgoState::Running;
+    }
+}
+
+void IDAStarPathfinder::enter(CellId cell, int g) {
+    Frame frame;
+    frame.cell = cell;
+    frame.g = g;
+    frame.next = 0;
+    frame.count = 0;
+    int f[8];
+    CellId parent = m_stack.empty() ? CellId::invalid() : m_stack.back().cell;
+    for (unsigned open_dirs = m_grid->getNeighborMask(cell); open_dirs; open_dirs &= open_dirs - 1) {
+        int i = bits::countTrailingZeros(open_dirs);
+        CellId neighbor = cell + m_grid->getNeighborOffset(i);
+        if (neighbor == parent) continue;
+        int neighbor_f = g + (i < 4 ? 10 : 14) + lookupH(neighbor);
+        if (neighbor_f > m_threshold) {
+            m_nextThreshold = std::min(m_nextThreshold, neighbor_f);
+            continue;
+        }
+        // Insertion sort by f; at most eight entries.
+        int k = frame.count++;
+        while (k > 0 && f[k - 1] > neighbor_f) {
+            f[k] = f[k - 1];
+            frame.dirs[k] = frame.dirs[k - 1];
+            --k;
+        }
+        f[k] = neighbor_f;
+        frame.dirs[k] = static_cast<std::uint8_t>(i);
+    }
+    m_stack.push_back(frame);
+    m_peakDepth = std::max(m_peakDepth, m_stack.size());
+    m_currentlyProcessing = m_grid->toPoint(cell);
+    ++m_expansions;
+}
+
+void IDAStarPathfinder::leave() {
+    CellId cell = m_stack.back().cell;
+    m_stack.pop_back();
+    // Every way on from here, including back, costs at least this much.
+    int h = std::numeric_limits<int>::max();
+    for (unsigned open_dirs = m_grid->getNeighborMask(cell); open_dirs; open_dirs &= open_dirs - 1) {
+        int i = bits::countTrailingZeros(open_dirs);
+        h = std::min(h, (i < 4 ? 10 : 14) + lookupH(cell + m_grid->getNeighborOffset(i)));
+    }
+    if (h == std::numeric_limits<int>::max()) return;
+    Entry& e = slot(cell);
+    e.h = std::max(e.h, static_cast<std::uint32_t>(h));
+}
+
+bool IDAStarPathfinder::checkAndRecord(CellId cell, int g) {
+    Entry& e = slot(cell);
+    if (e.pass == m_pass && e.g <= static_cast<std::uint32_t>(g)) return true;
+    e.g = static_cast<std::uint32_t>(g);
+    e.pass = m_pass;
+    return false;
+}
+
+IDAStarPathfinder::Entry& IDAStarPathfinder::slot(CellId cell) {
+    Entry* bucket = &m_table[(cell.value * 0x9E3779B1u >> 7 & m_bucketMask) * kWays];
+    Entry* victim = bucket;
+    for (int i = 0; i < kWays; ++i) {
+        Entry& e = bucket[i];
+        if (e.cell == cell.value) return e;
+        // Prefer an empty slot, then one not entered this pass, then the
+        // deepest entry: its subtree is the cheapest to search again.
+        auto rank = [this](const Entry& x) { return x.cell == 0 ? 0 : x.pass != m_pass ? 1 : 2; };
+        if (rank(e) < rank(*victim) || (rank(e) == rank(*victim) && e.g > victim->g)) victim = &e;
+    }
+    *victim = Entry{cell.value, std::numeric_limits<std::uint32_t>::max(), 0, static_cast<std::uint32_t>(heuristic(cell))};
+    return *victim;
+}
+
+const IDAStarPathfinder::Entry* IDAStarPathfinder::find(CellId cell) const {
+    const Entry* bucket = &m_table[(cell.value * 0x9E3779B1u >> 7 & m_bucketMask) * kWays];
+    for (int i = 0; i < kWays; ++i) {
+        if (bucket[i].cell == cell.value) return &bucket[i];
+    }
+    return nullptr;
+}
+
+int IDAStarPathfinder::lookupH(CellId cell) const {
+    const Entry* e = find(cell);
+    return e ? static_cast<int>(e->h) : heuristic(cell);
+}
+
+bool IDAStarPathfinder::isVisitedFwd(CellId id) const {
+    const Entry* e = find(id);
+    return e && e->pass == m_pass;
+}
+
+std::size_t IDAStarPathfinder::getPeakMemoryBytes() const {
+    return m_table.capacity() * sizeof(Entry) + m_peakDepth * sizeof(Frame);
+}
+
+int IDAStarPathfinder::heuristic(CellId cell) const {
+    Point p = m_grid->toPoint(cell);
+    int dr = std::abs(p.first - m_end.first);
+    int dc = std::abs(p.second - m_end.second);
+    return 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "JumpPointSearchPathfinder.h"
+#include "Bits.h"
+#include "Directions.h"
+#include <algorithm>
+#include <cmath>
+
+using dirs::bit;
+using dirs::sign;
+
+JumpPointSearchPathfinder::JumpPointSearchPathfinder(bool precomputed, OpenListKind openList)
+    : m_precomputed(precomputed), m_open(openList) {
+    m_name = precomputed ? "JPS+" : "Jump Point Search";
+    m_name += getOpenListLabel(openList);
+}
+
+std::string JumpPointSearchPathfinder::getName() const { return m_name; }
+
+void JumpPointSearchPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    m_state.resize(m_grid->getCellCount());
+    m_state.reset();
+    m_start = start;
+    m_end = end;
+    m_endCell = m_grid->index(m_end);
+    // JPS+ falls back to scanning until the grid's jump table has been built.
+    m_useTable = m_precomputed && m_grid->hasJumpTable();
+    m_open.reset(m_grid->getCellCount());
+    m_path.clear();
+
+    CellId start_cell = m_grid->index(m_start);
+    if (!m_grid->isReachable(start_cell, m_endCell)) return;
+    m_state.setGScore(start_cell, 0);
+    m_open.push(start_cell, heuristic(m_start, m_end));
+}
+
+void JumpPointSearchPathfinder::onWallChanged(const Point& pos) {
+    init(*m_grid, m_start, m_end);
+}
+
+AlgoState JumpPointSearchPathfinder::step() {
+    if (m_open.empty()) {
+        m_currentlyProcessing = {-1, -1};
+        return AlgoState::PathNotFound;
+    }
+
+    CellId current = m_open.pop();
+    if (m_state.isVisitedFwd(current)) {
+        return AlgoState::Running;
+    }
+    m_state.setVisitedFwd(current);
+    Point current_pos = m_grid->toPoint(current);
+    m_currentlyProcessing = current_pos;
+
+    if (current == m_endCell) {
+        m_path = expandPath(m_state.reconstructPath(*m_grid, m_endCell));
+        m_currentlyProcessing = {-1, -1};
+        return AlgoState::PathFound;
+    }
+
+    // Direction of travel into this jump point; (0, 0) for the start.
+    int dr = 0, dc = 0;
+    CellId parent = m_state.getParent(current);
+    if (parent.isValid()) {
+        Point parent_pos = m_grid->toPoint(parent);
+        dr = sign(current_pos.first - parent_pos.first);
+        dc = sign(current_pos.second - parent_pos.second);
+    }
+
+    int current_g = m_state.getGScore(current);
+    for (unsigned moves = prunedDirections(current, dr, dc); moves; moves &= moves - 1) {
+        int dir = bits::countTrailingZeros(moves);
+        CellId jump_point = jump(current, dir);
+        if (!jump_point.isValid()) continue;
+
+        Point jump_pos = m_grid->toPoint(jump_point);
+        int distance = std::max(std::abs(jump_pos.first - current_pos.first), std::abs(jump_pos.second - current_pos.second));
+        int tentative_g_score = current_g + distance * (dir < 4 ? 10 : 14);
+        if (tentative_g_score < m_state.getGScore(jump_point)) {
+            m_state.setParent(jump_point, current);
+            m_state.setGScore(jump_point, tentative_g_score);
+            m_open.push(jump_point, tentative_g_score + heuristic(jump_pos, m_end), tentative_g_score);
+        }
+    }
+    return AlgoState::Running;
+}
+
+// Natural neighbours plus forced ones for a cell entered moving (dr, dc).
+std::uint8_t JumpPointSearchPathfinder::prunedDirections(CellId cell, int dr, int dc) const {
+    unsigned open = m_grid->getNeighborMask(cell);
+    if (dr == 0 && dc == 0) return static_cast<std::uint8_t>(open);
+
+    unsigned moves = 0;
+    if (dr != 0 && dc != 0) {
+        moves = bit(dr, 0) | bit(0, dc) | bit(dr, dc);
+        if (!(open & bit(0, -dc))) moves |= bit(dr, -dc);
+        if (!(open & bit(-dr, 0))) moves |= bit(-dr, dc);
+    } else if (dr != 0) {
+        moves = bit(dr, 0);
+        if (!(open & bit(0, 1))) moves |= bit(dr, 1);
+        if (!(open & bit(0, -1))) moves |= bit(dr, -1);
+    } else {
+        moves = bit(0, dc);
+        if (!(open & bit(1, 0))) moves |= bit(1, dc);
+        if (!(open & bit(-1, 0))) moves |= bit(-1, dc);
+    }
+    return static_cast<std::uint8_t>(moves & open);
+}
+
+CellId JumpPointSearchPathfinder::jump(CellId from, int dir) const {
+    if (m_useTable) return jumpPrecomputed(from, dir);
+    if (dir < 4) return jumpStraight(from, dir);
+
+    int offset = m_grid->getNeighborOffset(dir);
+    int horizontal = dirs::index(0, dirs::kDc[dir]);
+    int vertical = dirs::index(dirs::kDr[dir], 0);
+    CellId cell = from;
+    while (true) {
+        cell = cell + offset;
+        if (m_grid->isWall(cell)) return CellId::invalid();
+        if (cell == m_endCell) return cell;
+
+        if (dirs::hasForcedNeighbor(m_grid->getNeighborMask(cell), dir)) return cell;
+        if (jumpStraight(cell, horizontal).isValid() || jumpStraight(cell, vertical).isValid()) {
+            return cell;
+        }
+    }
+}
+
+// JPS+: one table lookup per direction. The table knows nothing about the
+// goal, so a move that would pass it (or, diagonally, cross its row or
+// column) stops there instead, as the scanning version would.
+CellId JumpPointSearchPathfinder::jumpPrecomputed(CellId from, int dir) const {
+    int distance = m_grid->getJumpDistance(from, dir);
+    int reach = std::abs(distance);
+    int offset = m_grid->getNeighborOffset(dir);
+    Point pos = m_grid->toPoint(from);
+    int gr = m_end.first - pos.first, gc = m_end.second - pos.second;
+    int dr = dirs::kDr[dir], dc = dirs::kDc[dir];
+
+    if (!dirs::isDiagonal(dir)) {
+        bool onRay = dr == 0 ? gr == 0 && sign(gc) == dc : gc == 0 && sign(gr) == dr;
+        if (onRay && std::abs(gr) + std::abs(gc) <= reach) return m_endCell;
+    } else if (sign(gr) == dr && sign(gc) == dc) {
+        int k = std::min(std::abs(gr), std::abs(gc));
+        if (k <= reach) return CellId(static_cast<std::uint32_t>(static_cast<int>(from.value) + k * offset));
+    }
+    if (distance <= 0) return CellId::invalid();
+    return CellId(static_cast<std::uint32_t>(static_cast<int>(from.value) + distance * offset));
+}
+
+CellId JumpPointSearchPathfinder::jumpStraight(CellId from, int dir) const {
+    if (dir == 3) return jumpEast(from);
+    if (dir == 2) return jumpWest(from);
+
+    int offset = m_grid->getNeighborOffset(dir);
+    CellId cell = from;
+    while (true) {
+        cell = cell + offset;
+        if (m_grid->isWall(cell)) return CellId::invalid();
+        if (cell == m_endCell) return cell;
+
+        if (dirs::hasForcedNeighbor(m_grid->getNeighborMask(cell), dir)) return cell;
+    }
+}
+
+// Horizontal jumps test 64 cells per iteration against the wall bitmap: a
+// cell is a jump point when the cell above (or below) it is a wall and the
+// one after that is open. The sentinel ring always ends the scan.
+CellId JumpPointSearchPathfinder::jumpEast(CellId from) const {
+    const int stride = m_grid->getStride();
+    const int goal = static_cast<int>(m_endCell.value);
+    for (int pos = static_cast<int>(from.value) + 1;; pos += 64) {
+        std::uint64_t walls = m_grid->getWallWord(pos);
+        std::uint64_t up = m_grid->getWallWord(pos - stride);
+        std::uint64_t up_next = m_grid->getWallWord(pos - stride + 1);
+        std::uint64_t down = m_grid->getWallWord(pos + stride);
+        std::uint64_t down_next = m_grid->getWallWord(pos + stride + 1);
+        std::uint64_t stop = walls | (up & ~up_next) | (down & ~down_next);
+        if (goal >= pos && goal < pos + 64) stop |= 1ULL << (goal - pos);
+        if (stop) {
+            int k = bits::countTrailingZeros(stop);
+            if (walls >> k & 1) return CellId::invalid();
+            return CellId(static_cast<std::uint32_t>(pos + k));
+        }
+    }
+}
+
+CellId JumpPointSearchPathfinder::jumpWest(CellId from) const {
+    const int stride = m_grid->getStride();
+    const int goal = static_cast<int>(m_endCell.value);
+    for (int pos = static_cast<int>(from.value) - 1;; pos -= 64) {
+        int base = pos - 63;
+        std::uint64_t walls = m_grid->getWallWord(base);
+        std::uint64_t up = m_grid->getWallWord(base - stride);
+        std::uint64_t up_prev = m_grid->getWallWord(base - stride - 1);
+        std::uint64_t down = m_grid->getWallWord(base + stride);
+        std::uint64_t down_prev = m_grid->getWallWord(base + stride - 1);
+        std::uint64_t stop = walls | (up & ~up_prev) | (down & ~down_prev);
+        if (goal <= pos && goal >= base) stop |= 1ULL << (goal - base);
+        if (stop) {
+            int k = bits::highestSetBit(stop);
+            if (walls >> k & 1) return CellId::invalid();
+            return CellId(static_cast<std::uint32_t>(base + k));
+        }
+    }
+}
+
+// Fills in the straight or diagonal runs between consecutive jump points.
+std::vector<Point> JumpPointSearchPathfinder::expandPath(const std::vector<Point>& jumpPoints) const {
+    std::vector<Point> path;
+    for (size_t i = 0; i < jumpPoints.size(); ++i) {
+        if (i == 0) {
+            path.push_back(jumpPoints[0]);
+            continue;
+        }
+        Point p = jumpPoints[i - 1];
+        int dr = sign(jumpPoints[i].first - p.first);
+        int dc = sign(jumpPoints[i].second - p.second);
+        while (p != jumpPoints[i]) {
+            p.first += dr;
+            p.second += dc;
+            path.push_back(p);
+        }
+    }
+    return path;
+}
+
+int JumpPointSearchPathfinder::heuristic(const Point& a, const Point& b) const {
+    // Octile distance: exact on an empty grid, so the search stays optimal
+    int dr = std::abs(a.first - b.first);
+    int dc = std::abs(a.second - b.second);
+    return 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+}
\ No newline at end of file
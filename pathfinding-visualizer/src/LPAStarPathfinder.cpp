@@ -0,0 +1,169 @@
+#include "LPAStarPathfinder.h"
+#include "Bits.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int kInfinity = SearchState::kInfinity;
+
+    inline int stepCost(int dir) { return dir < 4 ? 10 : 14; }
+}
+
+LPAStarPathfinder::LPAStarPathfinder() {
+    m_name = "LPA* (incremental)";
+}
+
+std::string LPAStarPathfinder::getName() const { return m_name; }
+
+void LPAStarPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    m_state.resize(m_grid->getCellCount());
+    m_state.reset();
+    m_g.assign(static_cast<size_t>(m_grid->getCellCount()), kInfinity);
+    m_rhs.assign(static_cast<size_t>(m_grid->getCellCount()), kInfinity);
+    m_open.reset(m_grid->getCellCount());
+    m_peakOpen = 0;
+    m_path.clear();
+    m_startCell = m_grid->index(start);
+    m_end = end;
+    m_endCell = m_grid->index(m_end);
+
+    m_rhs[m_startCell.value] = 0;
+    m_open.push(m_startCell, calculateKey(m_startCell));
+    m_peakOpen = 1;
+}
+
+// Only edges touching the edited cell change cost, so only that cell and its
+// open neighbours can become inconsistent.
+void LPAStarPathfinder::onWallChanged(const Point& pos) {
+    CellId cell = m_grid->index(pos);
+    m_state.reset();
+    m_path.clear();
+
+    if (m_grid->isWall(cell)) {
+        int old_g = m_g[cell.value];
+        m_g[cell.value] = kInfinity;
+        m_rhs[cell.value] = kInfinity;
+        m_open.remove(cell);
+        if (old_g == kInfinity) return;
+        for (int dir = 0; dir < 8; ++dir) {
+            CellId neighbor = cell + m_grid->getNeighborOffset(dir);
+            if (m_grid->isWall(neighbor) || neighbor == m_startCell) continue;
+            // Neighbours that were supported through the new wall lose that support.
+            if (m_rhs[neighbor.value] == old_g + stepCost(dir)) {
+                m_rhs[neighbor.value] = bestPredecessorCost(neighbor);
+                updateVertex(neighbor);
+            }
+        }
+    } else {
+        // A freshly opened cell may now be reached; its neighbours improve
+        // through it once it is expanded. The start keeps rhs = 0: callers
+        // report edits on it even though toggleWall ignores them.
+        if (cell != m_startCell) m_rhs[cell.value] = bestPredecessorCost(cell);
+        updateVertex(cell);
+    }
+}
+
+AlgoState LPAStarPathfinder::step() {
+    std::uint64_t goal_key = calculateKey(m_endCell);
+    if (m_open.empty() || (m_open.top().key >= goal_key && m_rhs[m_endCell.value] == m_g[m_endCell.value])) {
+        m_currentlyProcessing = {-1, -1};
+        if (m_g[m_endCell.value] == kInfinity) return AlgoState::PathNotFound;
+        extractPath();
+        return AlgoState::PathFound;
+    }
+
+    CellId current = m_open.top().cell;
+    m_open.pop();
+    m_state.setVisitedFwd(current);
+    m_currentlyProcessing = m_grid->toPoint(current);
+
+    unsigned open_dirs = m_grid->getNeighborMask(current);
+    if (m_g[current.value] > m_rhs[current.value]) {
+        // Overconsistent: settle g, and successors may only get cheaper.
+        int g = m_rhs[current.value];
+        m_g[current.value] = g;
+        for (; open_dirs; open_dirs &= open_dirs - 1) {
+            int dir = bits::countTrailingZeros(open_dirs);
+            CellId neighbor = current + m_grid->getNeighborOffset(dir);
+            if (g + stepCost(dir) < m_rhs[neighbor.value]) {
+                m_rhs[neighbor.value] = g + stepCost(dir);
+                updateVertex(neighbor);
+            }
+        }
+    } else {
+        // Underconsistent: g was too optimistic. Invalidate it and re-derive
+        // rhs for the cell and every successor that relied on it.
+        int old_g = m_g[current.value];
+        m_g[current.value] = kInfinity;
+        if (current != m_startCell) m_rhs[current.value] = bestPredecessorCost(current);
+        updateVertex(current);
+        for (; open_dirs; open_dirs &= open_dirs - 1) {
+            int dir = bits::countTrailingZeros(open_dirs);
+            CellId neighbor = current + m_grid->getNeighborOffset(dir);
+            if (neighbor != m_startCell && m_rhs[neighbor.value] == old_g + stepCost(dir)) {
+                m_rhs[neighbor.value] = bestPredecessorCost(neighbor);
+                updateVertex(neighbor);
+            }
+        }
+    }
+    return AlgoState::Running;
+}
+
+int LPAStarPathfinder::heuristic(CellId cell) const {
+    // Octile distance: consistent for the 10/14 model, as LPA* requires
+    Point p = m_grid->toPoint(cell);
+    int dr = std::abs(p.first - m_end.first);
+    int dc = std::abs(p.second - m_end.second);
+    return 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+}
+
+// [min(g, rhs) + h; min(g, rhs)] compared lexicographically, packed into one word.
+std::uint64_t LPAStarPathfinder::calculateKey(CellId cell) const {
+    int k2 = std::min(m_g[cell.value], m_rhs[cell.value]);
+    if (k2 == kInfinity) return ~0ULL;
+    std::uint64_t k1 = static_cast<std::uint64_t>(k2) + heuristic(cell);
+    return k1 << 32 | static_cast<std::uint32_t>(k2);
+}
+
+int LPAStarPathfinder::bestPredecessorCost(CellId cell) const {
+    int best = kInfinity;
+    for (unsigned open_dirs = m_grid->getNeighborMask(cell); open_dirs; open_dirs &= open_dirs - 1) {
+        int dir = bits::countTrailingZeros(open_dirs);
+        int g = m_g[(cell + m_grid->getNeighborOffset(dir)).value];
+        if (g != kInfinity) best = std::min(best, g + stepCost(dir));
+    }
+    return best;
+}
+
+void LPAStarPathfinder::updateVertex(CellId cell) {
+    if (m_g[cell.value] != m_rhs[cell.value]) {
+        m_open.push(cell, calculateKey(cell));
+        m_peakOpen = std::max(m_peakOpen, m_open.size());
+    } else {
+        m_open.remove(cell);
+    }
+}
+
+// Walks back from the goal, always to the predecessor that explains its g.
+void LPAStarPathfinder::extractPath() {
+    m_path.clear();
+    CellId cell = m_endCell;
+    m_path.push_back(m_grid->toPoint(cell));
+    while (cell != m_startCell) {
+        CellId best = CellId::invalid();
+        int best_cost = kInfinity;
+        for (unsigned open_dirs = m_grid->getNeighborMask(cell); open_dirs; open_dirs &= open_dirs - 1) {
+            int dir = bits::countTrailingZeros(open_dirs);
+            CellId neighbor = cell + m_grid->getNeighborOffset(dir);
+            int g = m_g[neighbor.value];
+            if (g != kInfinity && g + stepCost(dir) < best_cost) {
+                best_cost = g + stepCost(dir);
+                best = neighbor;
+            }
+        }
+        cell = best;
+        m_path.push_back(m_grid->toPoint(cell));
+    }
+    std::reverse(m_path.begin(), m_path.end());
+}
\ No newline at end of file
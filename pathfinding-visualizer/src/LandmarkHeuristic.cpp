@@ -0,0 +1,51 @@
+#include "LandmarkHeuristic.h"
+#include "DeltaStepping.h"
+#include "SearchState.h"
+#include <algorithm>
+#include <cstdlib>
+
+void LandmarkHeuristic::build(const Grid& grid) {
+    m_grid = &grid;
+    m_version = grid.getVersion();
+    m_landmarks.clear();
+    m_distances.clear();
+
+    const int cells = grid.getCellCount();
+    CellId seed = grid.index(grid.getStart());
+    if (grid.isWall(seed)) return;
+
+    // The first landmark is the cell farthest from the start; each next one
+    // is the cell farthest from all landmarks chosen so far.
+    std::vector<int> nearest = computeDistances(grid, seed);
+    for (int k = 0; k < m_count; ++k) {
+        CellId farthest = CellId::invalid();
+        int best = -1;
+        for (int i = 0; i < cells; ++i) {
+            if (nearest[i] != SearchState::kInfinity && nearest[i] > best) {
+                best = nearest[i];
+                farthest = CellId(static_cast<std::uint32_t>(i));
+            }
+        }
+        if (best <= 0) break;
+
+        m_landmarks.push_back(farthest);
+        m_distances.push_back(computeDistances(grid, farthest));
+        const std::vector<int>& table = m_distances.back();
+        if (k == 0) nearest = table;
+        else for (int i = 0; i < cells; ++i) nearest[i] = std::min(nearest[i], table[i]);
+    }
+}
+
+int LandmarkHeuristic::estimate(CellId from, CellId to) const {
+    Point a = m_grid->toPoint(from), b = m_grid->toPoint(to);
+    int dr = std::abs(a.first - b.first);
+    int dc = std::abs(a.second - b.second);
+    int best = 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+    for (const std::vector<int>& table : m_distances) {
+        int da = table[from.value], db = table[to.value];
+        // Cells opened after the build have no entry and give no bound.
+        if (da == SearchState::kInfinity || db == SearchState::kInfinity) continue;
+        best = std::max(best, std::abs(da - db));
+    }
+    return best;
+}
\ No newline at end of file
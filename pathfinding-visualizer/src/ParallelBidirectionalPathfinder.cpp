@@ -0,0 +1,167 @@
+#include "ParallelBidirectionalPathfinder.h"
+#include "Bits.h"
+#include <algorithm>
+#include <cmath>
+
+constexpr std::uint64_t ParallelBidirectionalPathfinder::kNoMeeting;
+constexpr int ParallelBidirectionalPathfinder::kTurnLength;
+
+ParallelBidirectionalPathfinder::ParallelBidirectionalPathfinder(int expansionsPerStep, int threads)
+    : m_expansionsPerStep(std::max(1, expansionsPerStep)) {
+    if (threads >= 2) {
+        m_pool.reset(new ThreadPool(2));
+        m_name = "Bidirectional A* (2 threads)";
+    } else {
+        m_name = "Bidirectional A* (octile, 1 thread)";
+    }
+}
+
+std::string ParallelBidirectionalPathfinder::getName() const { return m_name; }
+
+void ParallelBidirectionalPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    int cells = m_grid->getCellCount();
+    m_state.resize(cells);
+    m_state.reset();
+    m_stateBwd.resize(cells);
+    m_stateBwd.reset();
+    if (m_publishedSize != cells || ++m_generation == 0) {
+        // New size, or the generation counter wrapped: start from clean arrays.
+        for (auto& published : m_published) {
+            published.reset(new std::atomic<std::uint64_t>[cells]);
+            for (int i = 0; i < cells; ++i) published[i].store(0, std::memory_order_relaxed);
+        }
+        m_publishedSize = cells;
+        m_generation = 1;
+    }
+    m_start = start;
+    m_end = end;
+    m_open[0].reset(cells);
+    m_open[1].reset(cells);
+    m_path.clear();
+    m_meeting.store(kNoMeeting);
+    m_finished.store(false);
+    m_lastExpanded[0] = m_lastExpanded[1] = {-1, -1};
+    m_currentlyProcessing = {-1, -1};
+
+    CellId start_cell = m_grid->index(m_start);
+    CellId end_cell = m_grid->index(m_end);
+    if (!m_grid->isReachable(start_cell, end_cell)) {
+        m_finished.store(true);
+        return;
+    }
+
+    // Both seeds are published before the workers start, which is all the
+    // termination test relies on; later publications only find meetings sooner.
+    m_state.setGScore(start_cell, 0);
+    publish(0, start_cell, 0);
+    m_open[0].push(start_cell, heuristic(m_start, m_end));
+
+    m_stateBwd.setGScore(end_cell, 0);
+    publish(1, end_cell, 0);
+    m_open[1].push(end_cell, heuristic(m_end, m_start));
+
+    if (start_cell == end_cell) offerMeeting(0, start_cell);
+}
+
+void ParallelBidirectionalPathfinder::onWallChanged(const Point& pos) {
+    init(*m_grid, m_start, m_end);
+}
+
+AlgoState ParallelBidirectionalPathfinder::step() {
+    if (m_pool && !m_finished.load()) {
+        m_pool->runOnAll([this](int side) { expand(side, m_expansionsPerStep); });
+    }
+    for (int done = 0; !m_pool && done < m_expansionsPerStep && !m_finished.load(); done += kTurnLength) {
+        int turn = std::min(kTurnLength, m_expansionsPerStep - done);
+        expand(0, turn);
+        expand(1, turn);
+    }
+    m_currentlyProcessing = m_lastExpanded[0];
+    if (!m_finished.load()) return AlgoState::Running;
+
+    std::uint64_t meeting = m_meeting.load();
+    if (meeting == kNoMeeting) return AlgoState::PathNotFound;
+    if (m_path.empty()) {
+        CellId meeting_cell(static_cast<std::uint32_t>(meeting));
+        m_path = m_state.reconstructPath(*m_grid, meeting_cell);
+        // The backward half runs goal -> meeting point; append it reversed.
+        std::vector<Point> back = m_stateBwd.reconstructPath(*m_grid, meeting_cell);
+        m_path.insert(m_path.end(), back.rbegin() + 1, back.rend());
+    }
+    return AlgoState::PathFound;
+}
+
+void ParallelBidirectionalPathfinder::expand(int side, int budget) {
+    const int dr[] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    const int dc[] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+    SearchState& state = side == 0 ? m_state : m_stateBwd;
+    OpenList& open = m_open[side];
+    const Point& target = side == 0 ? m_end : m_start;
+
+    for (int n = 0; n < budget; ++n) {
+        if (m_finished.load(std::memory_order_relaxed)) return;
+        // An exhausted side has reached every cell of the component, the
+        // other seed included, so the best meeting so far is optimal.
+        if (open.empty() || open.topPriority() >= meetingCost()) {
+            m_finished.store(true);
+            return;
+        }
+
+        CellId curr = open.pop();
+        if (state.isVisitedFwd(curr)) continue;
+        state.setVisitedFwd(curr);
+        Point curr_pos = m_grid->toPoint(curr);
+        m_lastExpanded[side] = curr_pos;
+        int curr_g = state.getGScore(curr);
+
+        for (unsigned open_dirs = m_grid->getNeighborMask(curr); open_dirs; open_dirs &= open_dirs - 1) {
+            int i = bits::countTrailingZeros(open_dirs);
+            CellId neighbor = curr + m_grid->getNeighborOffset(i);
+
+            int tentative_g_score = curr_g + ((i < 4) ? 10 : 14);
+            if (tentative_g_score < state.getGScore(neighbor)) {
+                state.setParent(neighbor, curr);
+                state.setGScore(neighbor, tentative_g_score);
+                publish(side, neighbor, tentative_g_score);
+                int other_g = readPublished(1 - side, neighbor);
+                if (other_g != SearchState::kInfinity) offerMeeting(tentative_g_score + other_g, neighbor);
+
+                Point neighbor_pos = {curr_pos.first + dr[i], curr_pos.second + dc[i]};
+                open.push(neighbor, tentative_g_score + heuristic(neighbor_pos, target));
+            }
+        }
+    }
+}
+
+// Relaxed ordering is enough: a stale read only delays a meeting, and every
+// value read is a real path cost from that side's seed.
+void ParallelBidirectionalPathfinder::publish(int side, CellId cell, int g) {
+    m_published[side][cell.value].store(static_cast<std::uint64_t>(m_generation) << 32 | static_cast<std::uint32_t>(g),
+                                        std::memory_order_relaxed);
+}
+
+int ParallelBidirectionalPathfinder::readPublished(int side, CellId cell) const {
+    std::uint64_t word = m_published[side][cell.value].load(std::memory_order_relaxed);
+    if (static_cast<std::uint32_t>(word >> 32) != m_generation) return SearchState::kInfinity;
+    return static_cast<int>(static_cast<std::uint32_t>(word));
+}
+
+int ParallelBidirectionalPathfinder::meetingCost() const {
+    std::uint64_t meeting = m_meeting.load();
+    return meeting == kNoMeeting ? SearchState::kInfinity : static_cast<int>(meeting >> 32);
+}
+
+void ParallelBidirectionalPathfinder::offerMeeting(int cost, CellId cell) {
+    std::uint64_t candidate = static_cast<std::uint64_t>(cost) << 32 | cell.value;
+    std::uint64_t best = m_meeting.load();
+    while (candidate < best && !m_meeting.compare_exchange_weak(best, candidate)) {}
+}
+
+int ParallelBidirectionalPathfinder::heuristic(const Point& pos, const Point& target) const {
+    // Octile distance: consistent for the 10/14 model, which the stopping rule needs
+    int dr = std::abs(pos.first - target.first);
+    int dc = std::abs(pos.second - target.second);
+    return 10 * std::max(dr, dc) + 4 * std::min(dr, dc);
+}
\ No newline at end of file
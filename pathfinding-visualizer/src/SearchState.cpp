@@ -0,0 +1,58 @@
+#include "SearchState.h"
+#include "Grid.h"
+#include <algorithm>
+
+constexpr int SearchState::kInfinity;
+constexpr std::uint8_t SearchState::kVisitedFwd;
+constexpr std::uint8_t SearchState::kVisitedBwd;
+
+void SearchState::resize(int cellCount) {
+    stamp.resize(cellCount, 0);
+    g_score.resize(cellCount);
+    parent.resize(cellCount);
+    g_score_bwd.resize(cellCount);
+    parent_bwd.resize(cellCount);
+    flags.resize(cellCount);
+}
+
+std::size_t SearchState::getMemoryBytes() const {
+    return stamp.capacity() * sizeof(std::uint32_t) + g_score.capacity() * sizeof(int) +
+           parent.capacity() * sizeof(CellId) + g_score_bwd.capacity() * sizeof(int) +
+           parent_bwd.capacity() * sizeof(CellId) + flags.capacity() * sizeof(std::uint8_t);
+}
+
+void SearchState::reset() {
+    if (++generation != 0) return;
+
+    // Counter wrapped: old stamps could alias new generations, so sweep once.
+    // The other arrays need no clearing since touch() rewrites them.
+    generation = 1;
+    std::fill(stamp.begin(), stamp.end(), 0);
+}
+
+std::vector<Point> SearchState::reconstructPath(const Grid& grid, CellId last, bool isBidirectional) const {
+    std::vector<Point> path;
+    if(isBidirectional) {
+        CellId curr = last;
+        while (curr.isValid()) {
+            path.push_back(grid.toPoint(curr));
+            curr = getParent(curr);
+        }
+        std::reverse(path.begin(), path.end());
+        
+        curr = getParentBwd(last);
+        while (curr.isValid()) {
+            path.push_back(grid.toPoint(curr));
+            curr = getParentBwd(curr);
+        }
+    } else {
+        // The start is the only reached cell without a parent.
+        CellId curr = last;
+        while (curr.isValid()) {
+            path.push_back(grid.toPoint(curr));
+            curr = getParent(curr);
+        }
+        std::reverse(path.begin(), path.end());
+    }
+    return path;
+}
\ No newline at end of file
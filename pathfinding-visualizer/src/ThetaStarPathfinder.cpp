@@ -0,0 +1,127 @@
+#include "ThetaStarPathfinder.h"
+#include "Bits.h"
+#include <algorithm>
+#include <cmath>
+
+constexpr int ThetaStarPathfinder::kUnit;
+
+ThetaStarPathfinder::ThetaStarPathfinder(bool lazy) : m_lazy(lazy) {}
+
+void ThetaStarPathfinder::init(const Grid& grid, const Point& start, const Point& end) {
+    m_grid = &grid;
+    const int cells = m_grid->getCellCount();
+    m_state.resize(cells);
+    m_state.reset();
+    m_open.reset(cells);
+    m_peakOpen = 0;
+    m_path.clear();
+    m_waypoints.clear();
+    m_pathLength = 0.0;
+    m_losChecks = 0;
+    m_done = false;
+    m_start = start;
+    m_end = end;
+    m_endCell = m_grid->index(end);
+
+    CellId start_cell = m_grid->index(start);
+    if (!m_grid->isReachable(start_cell, m_endCell)) return;
+    // The start keeps an invalid parent, which is how reconstructPath stops.
+    m_state.setGScore(start_cell, 0);
+    m_open.push(start_cell, calculateKey(start_cell, 0));
+    m_peakOpen = 1;
+}
+
+void ThetaStarPathfinder::onWallChanged(const Point& pos) {
+    init(*m_grid, m_start, m_end);
+}
+
+AlgoState ThetaStarPathfinder::step() {
+    if (m_done) return m_path.empty() ? AlgoState::PathNotFound : AlgoState::PathFound;
+    if (m_open.empty()) {
+        m_done = true;
+        return AlgoState::PathNotFound;
+    }
+
+    CellId current = m_open.top().cell;
+    m_open.pop();
+    if (m_lazy) setVertex(current);
+    m_state.setVisitedFwd(current);
+    m_currentlyProcessing = m_grid->toPoint(current);
+
+    if (current == m_endCell) {
+        m_waypoints = m_state.reconstructPath(*m_grid, m_endCell);
+        m_pathLength = static_cast<double>(m_state.getGScore(m_endCell)) / kUnit;
+        for (size_t i = 0; i + 1 < m_waypoints.size(); ++i) {
+            m_grid->appendLine(m_waypoints[i], m_waypoints[i + 1], m_path);
+            if (i + 2 < m_waypoints.size()) m_path.pop_back(); // next line starts on it again
+        }
+        if (m_path.empty()) m_path.push_back(m_end);
+        m_done = true;
+        return AlgoState::PathFound;
+    }
+
+    CellId parent = m_state.getParent(current);
+    if (!parent.isValid()) parent = current;
+    int current_g = m_state.getGScore(current);
+    int parent_g = m_state.getGScore(parent);
+
+    for (unsigned open_dirs = m_grid->getNeighborMask(current); open_dirs; open_dirs &= open_dirs - 1) {
+        int i = bits::countTrailingZeros(open_dirs);
+        CellId neighbor = current + m_grid->getNeighborOffset(i);
+        if (m_state.isVisitedFwd(neighbor)) continue;
+
+        // Path 2: straight from current's parent, when (assumed) visible.
+        CellId via = parent;
+        int tentative_g = parent_g + distance(parent, neighbor);
+        if (!m_lazy && parent != current && !lineOfSight(parent, neighbor)) {
+            via = current;
+            tentative_g = current_g + (i < 4 ? kUnit : distance(current, neighbor));
+        }
+        if (tentative_g >= m_state.getGScore(neighbor)) continue;
+        m_state.setParent(neighbor, via);
+        m_state.setGScore(neighbor, tentative_g);
+        m_open.push(neighbor, calculateKey(neighbor, tentative_g));
+    }
+    m_peakOpen = std::max(m_peakOpen, m_open.size());
+    return AlgoState::Running;
+}
+
+void ThetaStarPathfinder::setVertex(CellId current) {
+    CellId parent = m_state.getParent(current);
+    if (!parent.isValid() || lineOfSight(parent, current)) return;
+
+    // Blocked: the cheapest expanded neighbour becomes the parent. There is
+    // at least one, the cell that queued current.
+    CellId best_parent = CellId::invalid();
+    int best_g = SearchState::kInfinity;
+    for (unsigned open_dirs = m_grid->getNeighborMask(current); open_dirs; open_dirs &= open_dirs - 1) {
+        int i = bits::countTrailingZeros(open_dirs);
+        CellId neighbor = current + m_grid->getNeighborOffset(i);
+        if (!m_state.isVisitedFwd(neighbor)) continue;
+        int g = m_state.getGScore(neighbor) + (i < 4 ? kUnit : distance(neighbor, current));
+        if (g < best_g) {
+            best_g = g;
+            best_parent = neighbor;
+        }
+    }
+    m_state.setParent(current, best_parent);
+    m_state.setGScore(current, best_g);
+}
+
+bool ThetaStarPathfinder::lineOfSight(CellId a, CellId b) {
+    ++m_losChecks;
+    return m_grid->hasLineOfSight(m_grid->toPoint(a), m_grid->toPoint(b));
+}
+
+int ThetaStarPathfinder::distance(CellId a, CellId b) const {
+    Point p = m_grid->toPoint(a);
+    Point q = m_grid->toPoint(b);
+    double dr = p.first - q.first;
+    double dc = p.second - q.second;
+    return static_cast<int>(std::lround(std::sqrt(dr * dr + dc * dc) * kUnit));
+}
+
+std::uint64_t ThetaStarPathfinder::calculateKey(CellId cell, int g) const {
+    std::uint64_t f = static_cast<std::uint64_t>(g) + static_cast<std::uint64_t>(distance(cell, m_endCell));
+    return f << 32 | (0xFFFFFFFFu - static_cast<std::uint32_t>(g));
+}
\ No newline at end of file
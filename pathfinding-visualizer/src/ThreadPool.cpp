@@ -0,0 +1,45 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+    for (int i = 0; i < threads; ++i) m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& t : m_threads) t.join();
+}
+
+void ThreadPool::runOnAll(const std::function<void(int worker)>& task) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_running = size();
+    ++m_round;
+    m_wake.notify_all();
+    m_done.wait(lock, [this] { return m_running == 0; });
+    m_task = nullptr;
+}
+
+void ThreadPool::workerLoop(int index) {
+    std::uint64_t seen = 0;
+    while (true) {
+        const std::function<void(int)>* task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_round != seen; });
+            if (m_stop) return;
+            seen = m_round;
+            task = m_task;
+        }
+        (*task)(index);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_running == 0) m_done.notify_one();
+        }
+    }
+}
\ No newline at end of file
@@ -15,7 +15,7 @@ void Visualizer::drawGrid(int y_offset, int x_offset, const IPathfinder& pf, Alg
     const Grid& grid = pf.getGrid();
     Point start = grid.getStart();
     Point end = grid.getEnd();
-    Point processing = grid.getCurrentlyProcessing();
+    Point processing = pf.getCurrentlyProcessing();
     
     const std::vector<Point>& path = pf.getPath();
     std::vector<std::vector<bool>> is_on_path(grid.getRows(), std::vector<bool>(grid.getCols(), false));
@@ -28,14 +28,17 @@ void Visualizer::drawGrid(int y_offset, int x_offset, const IPathfinder& pf, Alg
     for (int r = 0; r < grid.getRows(); ++r) {
         for (int c = 0; c < grid.getCols(); ++c) {
             util::setCursorPosition(r + y_offset, c * 2 + x_offset);
-            const Node& node = grid.getNode(r, c);
+            CellId idx = grid.index(r, c);
+            bool is_wall = grid.isWall(idx);
             
             #ifdef _WIN32
+            bool visited_fwd = pf.isVisitedFwd(idx);
+            bool visited_bwd = pf.isVisitedBwd(idx);
             int color = 7; // Default
-            if (node.is_wall) color = 8;
-            else if (node.visited_fwd && node.visited_bwd) color = 5; // Meeting nodes
-            else if (node.visited_fwd) color = 13; // Visited by forward
-            else if (node.visited_bwd) color = 9;  // Visited by backward
+            if (is_wall) color = 8;
+            else if (visited_fwd && visited_bwd) color = 5; // Meeting nodes
+            else if (visited_fwd) color = 13; // Visited by forward
+            else if (visited_bwd) color = 9;  // Visited by backward
             
             if (r == start.first && c == start.second) color = 10;
             else if (r == end.first && c == end.second) color = 11;
@@ -48,7 +51,7 @@ void Visualizer::drawGrid(int y_offset, int x_offset, const IPathfinder& pf, Alg
             SetConsoleTextAttribute(hConsole, color);
             #endif
             
-            if (node.is_wall) std::cout << "##";
+            if (is_wall) std::cout << "##";
             else if (r == start.first && c == start.second) std::cout << " S";
             else if (r == end.first && c == end.second) std::cout << " E";
             else if (is_on_path[r][c]) std::cout << " *";
@@ -60,20 +63,75 @@ void Visualizer::drawGrid(int y_offset, int x_offset, const IPathfinder& pf, Alg
 
 void Visualizer::drawUI(const std::vector<std::unique_ptr<IPathfinder>>& pathfinders, const std::vector<AlgoState>& states, const Point* cursor, int speed) {
     util::clearScreen();
+    // Panels are laid out kPanelsPerRow to a row so the view stays within
+    // a normal console width as pathfinders are added.
+    const size_t kPanelsPerRow = 4;
+    int panel_height = pathfinders.empty() ? 3 : pathfinders[0]->getGrid().getRows() + 2;
     int x_offset = 0;
 
     for (size_t i = 0; i < pathfinders.size(); ++i) {
-        util::setCursorPosition(0, x_offset);
+        if (i % kPanelsPerRow == 0) x_offset = 0;
+        int y_offset = static_cast<int>(i / kPanelsPerRow) * panel_height;
+        util::setCursorPosition(y_offset, x_offset);
         std::cout << pathfinders[i]->getName();
         if (states[i] == AlgoState::PathFound) std::cout << " - Hoan thanh!";
         if (states[i] == AlgoState::PathNotFound) std::cout << " - That bai!";
 
-        drawGrid(1, x_offset, *pathfinders[i], states[i], cursor);
+        drawGrid(y_offset + 1, x_offset, *pathfinders[i], states[i], cursor);
         x_offset += pathfinders[i]->getGrid().getCols() * 2 + 5;
     }
 
-    int bottom_line = pathfinders.empty() ? 5 : pathfinders[0]->getGrid().getRows() + 2;
+    size_t panel_rows = (pathfinders.size() + kPanelsPerRow - 1) / kPanelsPerRow;
+    int bottom_line = pathfinders.empty() ? 5 : static_cast<int>(panel_rows) * panel_height;
     util::setCursorPosition(bottom_line, 0);
     std::cout << "Di chuyen: WASD | Them/Xoa tuong: Space | Tang/Giam toc: +/- | Thoat: Q\n";
     std::cout << "Toc do: " << speed << " buoc/khung hinh\n";
+}
+
+void Visualizer::drawAgents(const Grid& grid, const CooperativePlanner& planner, int lastConflicts) {
+    util::clearScreen();
+    util::setCursorPosition(0, 0);
+    std::cout << "Nhieu tac tu: " << planner.getAgents().size() << " (Cooperative A*)";
+    if (planner.isFinished()) std::cout << " - Hoan thanh!";
+
+    // Cell -> agent standing on it / agent whose goal it is.
+    std::vector<int> agent_at(static_cast<size_t>(grid.getRows()) * grid.getCols(), -1);
+    std::vector<int> goal_of(agent_at.size(), -1);
+    const std::vector<AgentTask>& agents = planner.getAgents();
+    const std::vector<Point>& positions = planner.getPositions();
+    for (size_t i = 0; i < agents.size(); ++i) {
+        goal_of[static_cast<size_t>(agents[i].goal.first) * grid.getCols() + agents[i].goal.second] = static_cast<int>(i);
+        agent_at[static_cast<size_t>(positions[i].first) * grid.getCols() + positions[i].second] = static_cast<int>(i);
+    }
+
+    for (int r = 0; r < grid.getRows(); ++r) {
+        util::setCursorPosition(r + 1, 0);
+        for (int c = 0; c < grid.getCols(); ++c) {
+            size_t cell = static_cast<size_t>(r) * grid.getCols() + c;
+            bool is_wall = grid.isWall(grid.index(r, c));
+
+            #ifdef _WIN32
+            int color = 7; // Default
+            if (is_wall) color = 8;
+            else if (agent_at[cell] >= 0) color = agents[agent_at[cell]].goal == positions[agent_at[cell]] ? 10 : 14;
+            else if (goal_of[cell] >= 0) color = 11;
+            HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+            SetConsoleTextAttribute(hConsole, color);
+            #endif
+
+            if (is_wall) std::cout << "##";
+            else if (agent_at[cell] >= 0) std::cout << ' ' << static_cast<char>('A' + agent_at[cell] % 26);
+            else if (goal_of[cell] >= 0) std::cout << ' ' << static_cast<char>('a' + goal_of[cell] % 26);
+            else std::cout << "  ";
+        }
+    }
+
+    #ifdef _WIN32
+    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 7);
+    #endif
+    util::setCursorPosition(grid.getRows() + 2, 0);
+    std::cout << "Buoc: " << planner.getTime() << " | Xung dot (buoc nay/tong): " << lastConflicts << "/"
+              << planner.getConflictCount() << " | Lap ke hoach: " << planner.getPlanningMilliseconds() << " ms"
+              << " | That bai: " << planner.getFailedPlanCount() << "\n";
+    std::cout << "Thoat: Q\n";
 }
\ No newline at end of file
@@ -1,8 +1,19 @@
 #include "Grid.h"
 #include "Visualizer.h"
 #include "AStarPathfinder.h"
+#include "ARAStarPathfinder.h"
+#include "IDAStarPathfinder.h"
+#include "FrontierSearchPathfinder.h"
+#include "ThetaStarPathfinder.h"
 #include "BidirectionalPathfinder.h"
+#include "ParallelBidirectionalPathfinder.h"
+#include "JumpPointSearchPathfinder.h"
+#include "LPAStarPathfinder.h"
+#include "HierarchicalPathfinder.h"
+#include "LandmarkHeuristic.h"
+#include "CooperativePlanner.h"
 #include "Util.h"
+#include "Benchmark.h"
 
 #include <iostream>
 #include <vector>
@@ -10,6 +21,7 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
 
 #ifdef _WIN32
 #include <conio.h>
@@ -19,19 +31,35 @@
 void runPathfinder() {
     Grid myGrid(21, 31);
     myGrid.generateMaze();
+    myGrid.buildJumpTable(); // for JPS+; toggleWall keeps it up to date
 
     Visualizer visualizer;
     
+    // Shared ALT tables; rebuilt after every edit, before the pathfinders restart.
+    auto landmarks = std::make_shared<LandmarkHeuristic>();
+    landmarks->build(myGrid);
+
     std::vector<std::unique_ptr<IPathfinder>> pathfinders;
     pathfinders.push_back(std::make_unique<AStarPathfinder>(false)); // A*
+    pathfinders.push_back(std::make_unique<AStarPathfinder>(false, OpenListKind::LazyBinaryHeap, landmarks)); // A* + ALT
     pathfinders.push_back(std::make_unique<AStarPathfinder>(true));  // Dijkstra
+    pathfinders.push_back(std::make_unique<ARAStarPathfinder>());
+    pathfinders.push_back(std::make_unique<IDAStarPathfinder>(16 << 10)); // table for about a thousand cells
     pathfinders.push_back(std::make_unique<BidirectionalPathfinder>());
+    pathfinders.push_back(std::make_unique<FrontierSearchPathfinder>());
+    pathfinders.push_back(std::make_unique<ParallelBidirectionalPathfinder>());
+    pathfinders.push_back(std::make_unique<JumpPointSearchPathfinder>());
+    pathfinders.push_back(std::make_unique<JumpPointSearchPathfinder>(true)); // JPS+
+    pathfinders.push_back(std::make_unique<LPAStarPathfinder>());
+    pathfinders.push_back(std::make_unique<HierarchicalPathfinder>(8));
+    pathfinders.push_back(std::make_unique<ThetaStarPathfinder>());
+    pathfinders.push_back(std::make_unique<ThetaStarPathfinder>(true)); // Lazy Theta*
 
-    std::vector<Grid> grids(pathfinders.size(), myGrid);
+    // All pathfinders read the same terrain; each keeps its own search state.
     std::vector<AlgoState> states(pathfinders.size(), AlgoState::Running);
 
     for(size_t i = 0; i < pathfinders.size(); ++i) {
-        pathfinders[i]->init(grids[i]);
+        pathfinders[i]->init(myGrid);
     }
 
     bool running = true;
@@ -48,8 +76,9 @@ void runPathfinder() {
                 case 'a': if (cursor.second > 0) cursor.second--; break;
                 case 'd': if (cursor.second < myGrid.getCols() - 1) cursor.second++; break;
                 case ' ':
-                    for (size_t i = 0; i < grids.size(); ++i) {
-                        grids[i].toggleWall(cursor);
+                    myGrid.toggleWall(cursor);
+                    landmarks->build(myGrid);
+                    for (size_t i = 0; i < pathfinders.size(); ++i) {
                         pathfinders[i]->onWallChanged(cursor);
                         states[i] = AlgoState::Running;
                     }
@@ -76,8 +105,34 @@ void runPathfinder() {
     }
 }
 
-int main() {
-    runPathfinder();
-    util::setCursorPosition(30, 0); // Move cursor to the end before exit
+// Several agents crossing one open map at once, planned cooperatively.
+void runAgents(int count) {
+    Grid myGrid = bench::makeScatterMap(21, 41, 12, std::random_device{}());
+    CooperativePlanner planner(16);
+    planner.reset(myGrid, bench::makeAgentTasks(myGrid, count, std::random_device{}()));
+
+    Visualizer visualizer;
+    int conflicts = 0;
+    visualizer.drawAgents(myGrid, planner, conflicts);
+    while (!planner.isFinished()) {
+        if (_kbhit() && _getch() == 'q') break;
+        conflicts = planner.tick();
+        visualizer.drawAgents(myGrid, planner, conflicts);
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        bench::runAll();
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--agents") {
+        int count = argc > 2 ? std::atoi(argv[2]) : 8;
+        runAgents(count > 0 ? count : 8);
+        util::setCursorPosition(25, 0);
+        return 0;
+    }
+    runPathfinder(); // the last frame leaves the cursor below its status lines
     return 0;
 }
\ No newline at end of file